@@ -1,56 +1,63 @@
 // FIFO.cpp
-#include "scheduler.h"
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
 #include <algorithm>
-#include <thread>
-#include <chrono>
 
-SimulationResult fifo(std::vector<Proceso>& procesos, UpdateCallback updateGUI) {
+void SeleccionFIFO::preparar(EstadoMotor& e) {
     // Ordenar por tiempo de llegada
-    std::sort(procesos.begin(), procesos.end(), [](const Proceso& a, const Proceso& b) {
+    std::stable_sort(e.procesos.begin(), e.procesos.end(), [](const Proceso& a, const Proceso& b) {
         return a.arrival_time < b.arrival_time;
     });
+    regresos.emplace(&e.arena);
+}
 
-    int tiempo = 0;
-    SimulationResult result;
-
-    for (auto& p : procesos) {
-        // Si hay tiempo de espera antes de que llegue el proceso
-        if (tiempo < p.arrival_time) {
-            // Agregar ciclos IDLE
-            while (tiempo < p.arrival_time) {
-                result.timeline.push_back({"IDLE", tiempo});
-                if (updateGUI) {
-                    updateGUI("IDLE", tiempo);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                }
-                tiempo++;
-            }
-        }
-        
-        p.waiting_time = tiempo - p.arrival_time;
-
-        // Ejecutar el proceso
-        for (int i = 0; i < p.burst_time; ++i) {
-            result.timeline.push_back({p.pid, tiempo});
-            if (updateGUI) {
-                updateGUI(p.pid, tiempo);
-                std::this_thread::sleep_for(std::chrono::milliseconds(300));
-            }
-            tiempo++;
-        }
+int SeleccionFIFO::seleccionar(EstadoMotor& e) {
+    bool hayNuevo = siguiente < (int)e.procesos.size() && e.procesos[siguiente].arrival_time <= e.tiempo;
 
-        p.turnaround_time = p.waiting_time + p.burst_time;
+    // Si el siguiente proceso aún no llega y nadie volvió de E/S, el CPU queda IDLE
+    if (!hayNuevo && regresos->empty()) {
+        return -1;
     }
 
-    // Calcular métricas
-    double total_wait = 0, total_tat = 0;
-    for (const auto& p : procesos) {
-        total_wait += p.waiting_time;
-        total_tat += p.turnaround_time;
+    if (e.config.traza) {
+        // Procesos que ya llegaron y siguen esperando detrás del elegido
+        auto llegados = std::upper_bound(e.procesos.begin(), e.procesos.end(), e.tiempo,
+            [](int t, const Proceso& q) { return t < q.arrival_time; }) - e.procesos.begin();
+        e.config.traza->colaListos(e.tiempo, (int)(llegados - siguiente) + (int)regresos->size() - 1);
     }
 
-    result.avgWaitingTime = total_wait / procesos.size();
-    result.avgTurnaroundTime = total_tat / procesos.size();
+    // Gana el que quedó listo primero: una llegada nueva o un regreso de E/S
+    if (!regresos->empty() && (!hayNuevo || regresos->front().second < e.procesos[siguiente].arrival_time)) {
+        int idx = regresos->front().first;
+        regresos->pop_front();
+        return idx;
+    }
+    return siguiente++;
+}
 
-    return result;
+void SeleccionFIFO::guardar(std::vector<int>& extra) const {
+    extra.push_back(siguiente);
+    for (const auto& [idx, listo] : *regresos) {
+        extra.push_back(idx);
+        extra.push_back(listo);
+    }
+}
+
+void SeleccionFIFO::restaurar(const EstadoMotor& e, const std::vector<int>& extra) {
+    siguiente = extra.empty() ? 0 : extra[0];
+    regresos->clear();
+    for (size_t i = 1; i + 1 < extra.size(); i += 2) {
+        regresos->push_back({extra[i], extra[i + 1]});
+    }
+}
+
+SimulationResult fifo(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                      const SimulationConfig& config) {
+    if (!updateGUI) {
+        if (auto result = formaCerrada(Algoritmo::FIFO, procesos, config)) {
+            return std::move(*result);
+        }
+    }
+    return correrPoliticas<SeleccionFIFO, SinExpropiacion>(procesos, std::move(updateGUI), config);
 }
@@ -1,87 +1,79 @@
-#include "scheduler.h"
-#include <queue>
-#include <thread>
-#include <chrono>
-#include <algorithm>
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
 
-SimulationResult roundRobin(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI) {
-    int tiempo = 0, completados = 0, n = procesos.size();
-    SimulationResult result;
-    std::queue<int> cola;
-
-    // Inicializar remaining_time
-    for (auto& p : procesos) {
-        p.remaining_time = p.burst_time;
-    }
-
-    while (completados < n) {
-        for (int i = 0; i < n; ++i) {
-            if (!procesos[i].en_cola && !procesos[i].terminado && 
-                procesos[i].arrival_time <= tiempo) {
-                cola.push(i);
-                procesos[i].en_cola = true;
-            }
+// Encolar los procesos que ya llegaron, en orden de índice
+void SeleccionRoundRobin::admitir(EstadoMotor& e) {
+    int n = e.procesos.size();
+    INSTR_CONTAR_N(ITERACIONES_SELECCION, n);
+    for (int i = 0; i < n; ++i) {
+        if (!e.procesos[i].en_cola && !e.procesos[i].terminado &&
+            e.procesos[i].arrival_time <= e.tiempo) {
+            cola->push(i);
+            INSTR_CONTAR(PUSH_COLA);
+            e.procesos[i].en_cola = true;
         }
+    }
+}
 
-        if (!cola.empty()) {
-            int idx = cola.front();
-            cola.pop();
-            auto& p = procesos[idx];
+// La cola vive en la arena de la corrida
+void SeleccionRoundRobin::preparar(EstadoMotor& e) {
+    cola.emplace(std::pmr::deque<int>(&e.arena));
+}
 
-            if (p.start_time == -1) {
-                p.start_time = tiempo;
-            }
+int SeleccionRoundRobin::seleccionar(EstadoMotor& e) {
+    admitir(e);
+    if (cola->empty()) {
+        return -1;
+    }
 
-            int ejecucion = std::min(quantum, p.remaining_time);
-            
-            for (int i = 0; i < ejecucion; ++i) {
-                result.timeline.push_back({p.pid, tiempo});
-                if (updateGUI) {
-                    updateGUI(p.pid, tiempo);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                }
-                tiempo++;
+    int idx = cola->front();
+    cola->pop();
+    INSTR_CONTAR(POP_COLA);
+    if (e.config.traza) {
+        e.config.traza->colaListos(e.tiempo, cola->size());
+    }
+    return idx;
+}
 
-                // Revisar si llegaron nuevos procesos mientras se ejecutaba
-                for (int j = 0; j < n; ++j) {
-                    if (!procesos[j].en_cola && !procesos[j].terminado && 
-                        procesos[j].arrival_time <= tiempo) {
-                        cola.push(j);
-                        procesos[j].en_cola = true;
-                    }
-                }
-            }
+void SeleccionRoundRobin::alExpropiar(EstadoMotor& e, int idx) {
+    cola->push(idx); // Volver a la cola
+    INSTR_CONTAR(PUSH_COLA);
+}
 
-            p.remaining_time -= ejecucion;
+// Las llegadas del mismo ciclo entran antes que el proceso que vuelve de E/S
+void SeleccionRoundRobin::alVolverDeES(EstadoMotor& e, int idx) {
+    admitir(e);
+    cola->push(idx);
+    INSTR_CONTAR(PUSH_COLA);
+}
 
-            if (p.remaining_time == 0) {
-                p.terminado = true;
-                p.turnaround_time = tiempo - p.arrival_time;
-                p.waiting_time = p.turnaround_time - p.burst_time;
-                completados++;
-            } else {
-                cola.push(idx); // Volver a la cola
-            }
+std::vector<int> SeleccionRoundRobin::colaListos(const EstadoMotor& e) const {
+    std::vector<int> listos;
+    guardar(listos);
+    return listos;
+}
 
-        } else {
-            result.timeline.push_back({"IDLE", tiempo});
-            if (updateGUI) {
-                updateGUI("IDLE", tiempo);
-                std::this_thread::sleep_for(std::chrono::milliseconds(300));
-            }
-            tiempo++;
-        }
+void SeleccionRoundRobin::guardar(std::vector<int>& extra) const {
+    // std::queue no expone iteradores; se recorre una copia
+    auto copia = *cola;
+    while (!copia.empty()) {
+        extra.push_back(copia.front());
+        copia.pop();
     }
+}
 
-    // Calcular métricas
-    double total_wait = 0, total_tat = 0;
-    for (const auto& p : procesos) {
-        total_wait += p.waiting_time;
-        total_tat += p.turnaround_time;
+void SeleccionRoundRobin::restaurar(const EstadoMotor& e, const std::vector<int>& extra) {
+    while (!cola->empty()) {
+        cola->pop();
     }
+    for (int idx : extra) {
+        cola->push(idx);
+    }
+}
 
-    result.avgWaitingTime = total_wait / procesos.size();
-    result.avgTurnaroundTime = total_tat / procesos.size();
-
-    return result;
+SimulationResult roundRobin(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI,
+                            const SimulationConfig& config) {
+    return correrPoliticas(procesos, std::move(updateGUI), config, SeleccionRoundRobin{},
+                           ExpropiacionPorQuantum{quantum});
 }
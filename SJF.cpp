@@ -1,62 +1,38 @@
 // SJF.cpp
-#include "scheduler.h"
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
 #include <climits>
-#include <thread>
-#include <chrono>
 
-SimulationResult sjf(std::vector<Proceso>& procesos, UpdateCallback updateGUI) {
-    int tiempo = 0, completados = 0, n = procesos.size();
-    SimulationResult result;
+int SeleccionSJF::seleccionar(EstadoMotor& e) {
+    int n = e.procesos.size();
+    int idx = -1, min_bt = INT_MAX, listos = 0;
 
-    while (completados < n) {
-        int idx = -1, min_bt = INT_MAX;
-
-        // Buscar el proceso con menor burst time entre los que han llegado
-        for (int i = 0; i < n; ++i) {
-            if (!procesos[i].terminado && procesos[i].arrival_time <= tiempo &&
-                procesos[i].burst_time < min_bt) {
-                min_bt = procesos[i].burst_time;
+    // Buscar el proceso con menor ráfaga de CPU entre los que han llegado
+    INSTR_CONTAR_N(ITERACIONES_SELECCION, n);
+    for (int i = 0; i < n; ++i) {
+        if (!e.procesos[i].terminado && !e.procesos[i].en_es && e.procesos[i].arrival_time <= e.tiempo) {
+            listos++;
+            int rafaga = rafagaActual(e.procesos[i]);
+            if (rafaga < min_bt) {
+                min_bt = rafaga;
                 idx = i;
             }
         }
-
-        if (idx != -1) {
-            auto& p = procesos[idx];
-            p.waiting_time = tiempo - p.arrival_time;
-            
-            // Ejecutar el proceso completo
-            for (int i = 0; i < p.burst_time; ++i) {
-                result.timeline.push_back({p.pid, tiempo});
-                if (updateGUI) {
-                    updateGUI(p.pid, tiempo);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                }
-                tiempo++;
-            }
-            
-            p.turnaround_time = p.waiting_time + p.burst_time;
-            p.terminado = true;
-            completados++;
-        } else {
-            // CPU IDLE
-            result.timeline.push_back({"IDLE", tiempo});
-            if (updateGUI) {
-                updateGUI("IDLE", tiempo);
-                std::this_thread::sleep_for(std::chrono::milliseconds(300));
-            }
-            tiempo++;
-        }
     }
 
-    // Calcular métricas
-    double total_wait = 0, total_tat = 0;
-    for (const auto& p : procesos) {
-        total_wait += p.waiting_time;
-        total_tat += p.turnaround_time;
+    if (e.config.traza) {
+        e.config.traza->colaListos(e.tiempo, listos - (idx != -1));
     }
+    return idx;
+}
 
-    result.avgWaitingTime = total_wait / procesos.size();
-    result.avgTurnaroundTime = total_tat / procesos.size();
-
-    return result;
+SimulationResult sjf(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                     const SimulationConfig& config) {
+    if (!updateGUI) {
+        if (auto result = formaCerrada(Algoritmo::SJF, procesos, config)) {
+            return std::move(*result);
+        }
+    }
+    return correrPoliticas<SeleccionSJF, SinExpropiacion>(procesos, std::move(updateGUI), config);
 }
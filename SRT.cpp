@@ -1,71 +1,32 @@
-#include "scheduler.h"
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
 #include <climits>
-#include <thread>
-#include <chrono>
 
-SimulationResult srt(std::vector<Proceso>& procesos, UpdateCallback updateGUI) {
-    int tiempo = 0, completados = 0, n = procesos.size();
-    SimulationResult result;
-
-    // Inicializar remaining_time
-    for (auto& p : procesos) {
-        p.remaining_time = p.burst_time;
-    }
-
-    while (completados < n) {
-        int idx = -1, min_rem = INT_MAX;
-
-        // Buscar el proceso con menor tiempo restante
-        for (int i = 0; i < n; ++i) {
-            if (!procesos[i].terminado && procesos[i].arrival_time <= tiempo &&
-                procesos[i].remaining_time < min_rem && procesos[i].remaining_time > 0) {
-                min_rem = procesos[i].remaining_time;
+int SeleccionSRT::seleccionar(EstadoMotor& e) {
+    int n = e.procesos.size();
+    int idx = -1, min_rem = INT_MAX, listos = 0;
+
+    // Buscar el proceso con menor tiempo restante; se repite cada ciclo
+    INSTR_CONTAR_N(ITERACIONES_SELECCION, n);
+    for (int i = 0; i < n; ++i) {
+        if (!e.procesos[i].terminado && !e.procesos[i].en_es && e.procesos[i].arrival_time <= e.tiempo &&
+            e.procesos[i].remaining_time > 0) {
+            listos++;
+            if (e.procesos[i].remaining_time < min_rem) {
+                min_rem = e.procesos[i].remaining_time;
                 idx = i;
             }
         }
-
-        if (idx != -1) {
-            auto& p = procesos[idx];
-
-            if (p.start_time == -1) {
-                p.start_time = tiempo;
-            }
-
-            result.timeline.push_back({p.pid, tiempo});
-            if (updateGUI) {
-                updateGUI(p.pid, tiempo);
-                std::this_thread::sleep_for(std::chrono::milliseconds(300));
-            }
-
-            p.remaining_time--;
-            tiempo++;
-
-            if (p.remaining_time == 0) {
-                p.terminado = true;
-                p.turnaround_time = tiempo - p.arrival_time;
-                p.waiting_time = p.turnaround_time - p.burst_time;
-                completados++;
-            }
-        } else {
-            // CPU IDLE
-            result.timeline.push_back({"IDLE", tiempo});
-            if (updateGUI) {
-                updateGUI("IDLE", tiempo);
-                std::this_thread::sleep_for(std::chrono::milliseconds(300));
-            }
-            tiempo++;
-        }
     }
 
-    // Calcular métricas
-    double total_wait = 0, total_tat = 0;
-    for (const auto& p : procesos) {
-        total_wait += p.waiting_time;
-        total_tat += p.turnaround_time;
+    if (e.config.traza) {
+        e.config.traza->colaListos(e.tiempo, listos - (idx != -1));
     }
+    return idx;
+}
 
-    result.avgWaitingTime = total_wait / procesos.size();
-    result.avgTurnaroundTime = total_tat / procesos.size();
-
-    return result;
+SimulationResult srt(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                     const SimulationConfig& config) {
+    return correrPoliticas<SeleccionSRT, ExpropiacionSiempre>(procesos, std::move(updateGUI), config);
 }
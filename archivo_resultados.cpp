@@ -0,0 +1,602 @@
+#include "archivo_resultados.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+// Formato (enteros de ancho fijo en el orden de bytes de la máquina que lo
+// escribió, verificado con MARCA_ORDEN):
+//
+//   "SCHEDRES" | version u32 | marca u32 | hashCarga u64
+//   por track:
+//     segmentos: corridas (zigzag Δid, largo-1, zigzag Δciclo) en varint;
+//                los ids 0..P-1 son los procesos y P.. las etiquetas extra
+//     índice:    u64 x (S+1), posición de cada segmento en el archivo
+//     extras:    offsets u64 x (E+1) | texto (CS, IDLE, ...)
+//     procesos:  offsets u64 x (P+1) | pids | espera, retorno, completación,
+//                respuesta (i32 x P cada columna) | orden por pid (u32 x P)
+//     meta:      nombre, métricas y sketches en varint, tamaños y posiciones
+//   tabla: varint número de tracks | u64 posición de cada meta
+//   pie:   u64 posición de la tabla | "SRES-FIN"
+namespace {
+
+constexpr char MAGICO[8] = {'S', 'C', 'H', 'E', 'D', 'R', 'E', 'S'};
+constexpr char MAGICO_FIN[8] = {'S', 'R', 'E', 'S', '-', 'F', 'I', 'N'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t MARCA_ORDEN = 0x01020304;
+constexpr size_t ENCABEZADO = 8 + 4 + 4 + 8;
+constexpr size_t PIE = 8 + 8;
+constexpr size_t RANURAS_SEGMENTO = HistorialGantt::RANURAS_POR_SEGMENTO;
+constexpr int COLUMNAS_PROCESO = 4;
+
+uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+int64_t deszigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+template <typename T>
+T leerFijo(const uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+// Escritura con búfer propio: el timeline se emite varint a varint
+class Escritor {
+public:
+    explicit Escritor(const std::string& archivo) : out(archivo, std::ios::binary) { bufer.reserve(CAPACIDAD); }
+
+    bool ok() const { return static_cast<bool>(out); }
+    uint64_t posicion() const { return escritos + bufer.size(); }
+
+    void byte(uint8_t b) {
+        bufer.push_back(b);
+        if (bufer.size() >= CAPACIDAD) vaciar();
+    }
+    void bytes(const void* datos, size_t n) {
+        const uint8_t* p = static_cast<const uint8_t*>(datos);
+        bufer.insert(bufer.end(), p, p + n);
+        if (bufer.size() >= CAPACIDAD) vaciar();
+    }
+    template <typename T>
+    void fijo(T v) { bytes(&v, sizeof(T)); }
+    void varint(uint64_t v) {
+        while (v >= 0x80) {
+            byte((uint8_t)v | 0x80);
+            v >>= 7;
+        }
+        byte((uint8_t)v);
+    }
+    void cadena(std::string_view s) {
+        varint(s.size());
+        bytes(s.data(), s.size());
+    }
+
+    bool cerrar() {
+        vaciar();
+        out.close();
+        return !out.fail();
+    }
+
+private:
+    void vaciar() {
+        out.write(reinterpret_cast<const char*>(bufer.data()), bufer.size());
+        escritos += bufer.size();
+        bufer.clear();
+    }
+
+    static constexpr size_t CAPACIDAD = 1 << 20;
+    std::ofstream out;
+    std::vector<uint8_t> bufer;
+    uint64_t escritos = 0;
+};
+
+// Lectura acotada sobre el archivo mapeado; salirse del rango deja ok en false
+struct Lector {
+    const uint8_t* p;
+    const uint8_t* fin;
+    bool ok = true;
+
+    bool hay(uint64_t n) {
+        if ((uint64_t)(fin - p) < n) ok = false;
+        return ok;
+    }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int desplazamiento = 0; desplazamiento < 64 && hay(1); desplazamiento += 7) {
+            uint8_t b = *p++;
+            v |= (uint64_t)(b & 0x7f) << desplazamiento;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    int64_t entero() { return deszigzag(varint()); }
+    template <typename T>
+    T fijo() {
+        if (!hay(sizeof(T))) return T();
+        T v = leerFijo<T>(p);
+        p += sizeof(T);
+        return v;
+    }
+    std::string cadena() {
+        uint64_t n = varint();
+        if (!hay(n)) return {};
+        std::string s(reinterpret_cast<const char*>(p), n);
+        p += n;
+        return s;
+    }
+};
+
+}
+
+// Solo las cubetas con datos: (Δíndice, cuenta)
+struct CodecSketch {
+    static void escribir(Escritor& out, const SketchCuantiles& s) {
+        out.varint(s.cantidad_);
+        out.varint(s.suma_);
+        out.varint(s.maximo_);
+        out.varint(std::count_if(s.cubetas_.begin(), s.cubetas_.end(), [](uint64_t c) { return c != 0; }));
+        int anterior = 0;
+        for (int i = 0; i < SketchCuantiles::NUM_CUBETAS; ++i) {
+            if (s.cubetas_[i] == 0) continue;
+            out.varint(i - anterior);
+            out.varint(s.cubetas_[i]);
+            anterior = i;
+        }
+    }
+
+    static SketchCuantiles leer(Lector& in) {
+        SketchCuantiles s;
+        s.cantidad_ = in.varint();
+        s.suma_ = in.varint();
+        s.maximo_ = (int)in.varint();
+        uint64_t llenas = in.varint();
+        uint64_t i = 0;
+        for (uint64_t k = 0; k < llenas && in.ok; ++k) {
+            i += in.varint();
+            uint64_t cuenta = in.varint();
+            if (i >= (uint64_t)SketchCuantiles::NUM_CUBETAS) {
+                in.ok = false;
+                break;
+            }
+            s.cubetas_[i] = cuenta;
+        }
+        return s;
+    }
+};
+
+namespace {
+
+void escribirResultado(Escritor& out, const SimulationResult& r) {
+    out.fijo(r.avgWaitingTime);
+    out.fijo(r.avgTurnaroundTime);
+    out.fijo(r.avgResponseTime);
+    out.fijo(r.cpuUtilization);
+    out.fijo(r.throughput);
+    out.varint(zigzag(r.contextSwitches));
+    out.varint(zigzag(r.makespan));
+    out.varint(zigzag(r.primerCiclo));
+    out.varint(zigzag(r.ultimoCiclo));
+    out.varint(zigzag(r.ciclosOcupados));
+    out.varint(r.utilizacionES.size());
+    for (double u : r.utilizacionES) out.fijo(u);
+    out.varint(r.ciclosOcupadosES.size());
+    for (long long c : r.ciclosOcupadosES) out.varint(zigzag(c));
+    CodecSketch::escribir(out, r.waiting);
+    CodecSketch::escribir(out, r.turnaround);
+    CodecSketch::escribir(out, r.response);
+}
+
+std::shared_ptr<SimulationResult> leerResultado(Lector& in) {
+    auto r = std::make_shared<SimulationResult>();
+    r->avgWaitingTime = in.fijo<double>();
+    r->avgTurnaroundTime = in.fijo<double>();
+    r->avgResponseTime = in.fijo<double>();
+    r->cpuUtilization = in.fijo<double>();
+    r->throughput = in.fijo<double>();
+    r->contextSwitches = (int)in.entero();
+    r->makespan = (int)in.entero();
+    r->primerCiclo = (int)in.entero();
+    r->ultimoCiclo = (int)in.entero();
+    r->ciclosOcupados = in.entero();
+    uint64_t dispositivos = in.varint();
+    for (uint64_t d = 0; d < dispositivos && in.hay(sizeof(double)); ++d) r->utilizacionES.push_back(in.fijo<double>());
+    dispositivos = in.varint();
+    for (uint64_t d = 0; d < dispositivos && in.ok; ++d) r->ciclosOcupadosES.push_back(in.entero());
+    r->waiting = CodecSketch::leer(in);
+    r->turnaround = CodecSketch::leer(in);
+    r->response = CodecSketch::leer(in);
+    return r;
+}
+
+// Devuelve la posición del bloque meta del track
+uint64_t escribirTrack(Escritor& out, const TrackResultados& track) {
+    // Los ids de etiqueta 0..P-1 son los procesos; después van las etiquetas
+    // que no son un pid (CS, IDLE), en orden de aparición
+    std::unordered_map<std::string_view, uint32_t> ids;
+    ids.reserve(track.procesos);
+    for (size_t i = 0; i < track.procesos; ++i) {
+        ids.emplace(track.proceso(i).pid, (uint32_t)i);
+    }
+    std::vector<std::string> extras;
+    std::unordered_map<std::string, uint32_t> idsExtra;
+    auto idDe = [&](const std::string& contenido) {
+        auto it = ids.find(contenido);
+        if (it != ids.end()) return it->second;
+        auto [extra, nueva] = idsExtra.emplace(contenido, (uint32_t)(track.procesos + extras.size()));
+        if (nueva) extras.push_back(contenido);
+        return extra->second;
+    };
+
+    // Segmentos: ranuras consecutivas con el mismo contenido y ciclos
+    // seguidos forman una corrida
+    std::vector<uint64_t> indice;
+    std::string actual;
+    std::string buscada;
+    uint32_t idBuscada = 0;
+    bool hayBuscada = false;
+    for (size_t inicio = 0; inicio < track.ranuras; inicio += RANURAS_SEGMENTO) {
+        indice.push_back(out.posicion());
+        size_t fin = std::min(track.ranuras, inicio + RANURAS_SEGMENTO);
+        int64_t idAnterior = 0;
+        int64_t cicloEsperado = 0;
+
+        auto emitir = [&](int ciclo, size_t largo) {
+            if (!hayBuscada || actual != buscada) {
+                idBuscada = idDe(actual);
+                buscada = actual;
+                hayBuscada = true;
+            }
+            out.varint(zigzag((int64_t)idBuscada - idAnterior));
+            out.varint(largo - 1);
+            out.varint(zigzag(ciclo - cicloEsperado));
+            idAnterior = idBuscada;
+            cicloEsperado = (int64_t)ciclo + largo;
+        };
+
+        const HistorialGantt::Ranura primera = track.ranura(inicio);
+        actual = primera.contenido;
+        int ciclo = primera.ciclo;
+        size_t largo = 1;
+        for (size_t i = inicio + 1; i < fin; ++i) {
+            const HistorialGantt::Ranura r = track.ranura(i);
+            if (r.ciclo == ciclo + (int)largo && r.contenido == actual) {
+                ++largo;
+                continue;
+            }
+            emitir(ciclo, largo);
+            actual = r.contenido;
+            ciclo = r.ciclo;
+            largo = 1;
+        }
+        emitir(ciclo, largo);
+    }
+    indice.push_back(out.posicion());
+
+    uint64_t inicioIndice = out.posicion();
+    for (uint64_t p : indice) out.fijo(p);
+
+    uint64_t inicioExtras = out.posicion();
+    uint64_t offset = 0;
+    for (const auto& e : extras) {
+        out.fijo(offset);
+        offset += e.size();
+    }
+    out.fijo(offset);
+    for (const auto& e : extras) out.bytes(e.data(), e.size());
+
+    // Columnas por proceso, cada una en su propia pasada
+    uint64_t inicioProcesos = out.posicion();
+    offset = 0;
+    for (size_t i = 0; i < track.procesos; ++i) {
+        out.fijo(offset);
+        offset += track.proceso(i).pid.size();
+    }
+    out.fijo(offset);
+    for (size_t i = 0; i < track.procesos; ++i) {
+        std::string_view pid = track.proceso(i).pid;
+        out.bytes(pid.data(), pid.size());
+    }
+    int MetricasProceso::*columnas[COLUMNAS_PROCESO] = {&MetricasProceso::waiting_time, &MetricasProceso::turnaround_time,
+                                                        &MetricasProceso::completion_time, &MetricasProceso::response_time};
+    for (auto columna : columnas) {
+        for (size_t i = 0; i < track.procesos; ++i) out.fijo((int32_t)(track.proceso(i).*columna));
+    }
+
+    // Procesos ordenados por pid, para buscar uno sin cargar la tabla
+    std::vector<std::pair<std::string_view, uint32_t>> orden(track.procesos);
+    for (size_t i = 0; i < orden.size(); ++i) orden[i] = {track.proceso(i).pid, (uint32_t)i};
+    std::sort(orden.begin(), orden.end());
+    for (const auto& [pid, i] : orden) out.fijo(i);
+
+    static const SimulationResult sinResultado;
+    uint64_t meta = out.posicion();
+    out.cadena(track.nombre);
+    escribirResultado(out, track.resultado ? *track.resultado : sinResultado);
+    out.varint(track.ranuras);
+    out.varint(track.procesos);
+    out.varint(extras.size());
+    out.fijo(inicioIndice);
+    out.fijo(inicioExtras);
+    out.fijo(inicioProcesos);
+    return meta;
+}
+
+}
+
+TrackResultados trackResultados(const std::string& nombre, const HistorialGantt& historial,
+                                ResultadoCompartido resultado, ProcesosCompartidos procesos) {
+    TrackResultados track;
+    track.nombre = nombre;
+    track.resultado = std::move(resultado);
+    track.ranuras = historial.size();
+    track.ranura = [&historial](size_t i) { return historial.en(i); };
+    track.procesos = procesos ? procesos->size() : 0;
+    track.proceso = [procesos](size_t i) {
+        const Proceso& p = (*procesos)[i];
+        return MetricasProceso{p.pid, p.waiting_time, p.turnaround_time, p.completion_time, p.response_time};
+    };
+    return track;
+}
+
+// FNV-1a de 64 bits
+uint64_t hashCarga(const std::vector<Proceso>& procesos) {
+    uint64_t h = 14695981039346656037ULL;
+    auto mezclar = [&h](const void* datos, size_t n) {
+        const uint8_t* p = static_cast<const uint8_t*>(datos);
+        for (size_t i = 0; i < n; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ULL;
+        }
+    };
+    auto entero = [&mezclar](int32_t v) { mezclar(&v, sizeof(v)); };
+    for (const auto& p : procesos) {
+        mezclar(p.pid.data(), p.pid.size() + 1);
+        entero(p.arrival_time);
+        entero(p.burst_time);
+        entero(p.priority);
+        entero((int32_t)p.es.size());
+        for (const auto& r : p.es) {
+            entero(r.dispositivo);
+            entero(r.duracion);
+            entero(r.cpu);
+        }
+    }
+    return h;
+}
+
+// Se escribe a un temporal y se renombra: el destino puede ser el archivo
+// del que salen los tracks, que sigue mapeado mientras se escribe
+bool guardarResultados(const std::string& archivo, uint64_t hashCarga, const std::vector<TrackResultados>& tracks) {
+    std::string temporal = archivo + ".tmp";
+    Escritor out(temporal);
+    if (!out.ok()) return false;
+
+    out.bytes(MAGICO, sizeof(MAGICO));
+    out.fijo(VERSION);
+    out.fijo(MARCA_ORDEN);
+    out.fijo(hashCarga);
+
+    std::vector<uint64_t> metas;
+    for (const auto& track : tracks) {
+        metas.push_back(escribirTrack(out, track));
+    }
+
+    uint64_t tabla = out.posicion();
+    out.varint(metas.size());
+    for (uint64_t m : metas) out.fijo(m);
+    out.fijo(tabla);
+    out.bytes(MAGICO_FIN, sizeof(MAGICO_FIN));
+    if (!out.cerrar() || std::rename(temporal.c_str(), archivo.c_str()) != 0) {
+        std::remove(temporal.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const ArchivoResultados> ArchivoResultados::abrir(const std::string& archivo) {
+    int fd = ::open(archivo.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || (size_t)info.st_size < ENCABEZADO + PIE) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* mapa = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // El mapeo sigue válido sin el descriptor
+    if (mapa == MAP_FAILED) return nullptr;
+
+    std::shared_ptr<ArchivoResultados> r(new ArchivoResultados());
+    r->base = static_cast<const uint8_t*>(mapa);
+    r->tamano = info.st_size;
+    const uint8_t* base = r->base;
+    size_t tamano = r->tamano;
+
+    if (std::memcmp(base, MAGICO, sizeof(MAGICO)) != 0 || leerFijo<uint32_t>(base + 8) != VERSION ||
+        leerFijo<uint32_t>(base + 12) != MARCA_ORDEN ||
+        std::memcmp(base + tamano - sizeof(MAGICO_FIN), MAGICO_FIN, sizeof(MAGICO_FIN)) != 0) {
+        return nullptr;
+    }
+    r->hash = leerFijo<uint64_t>(base + 16);
+
+    uint64_t tabla = leerFijo<uint64_t>(base + tamano - PIE);
+    if (tabla < ENCABEZADO || tabla > tamano - PIE) return nullptr;
+    Lector lectorTabla{base + tabla, base + tamano - PIE};
+    uint64_t numTracks = lectorTabla.varint();
+    if (!lectorTabla.hay(numTracks * sizeof(uint64_t))) return nullptr;
+
+    // Una sección [inicio, inicio + bytes) debe caer antes de la tabla
+    auto dentro = [tabla](uint64_t inicio, uint64_t bytes) {
+        return inicio >= ENCABEZADO && inicio <= tabla && bytes <= tabla - inicio;
+    };
+
+    r->datos.resize(numTracks);
+    for (uint64_t t = 0; t < numTracks; ++t) {
+        uint64_t meta = lectorTabla.fijo<uint64_t>();
+        if (!dentro(meta, 0)) return nullptr;
+        Lector in{base + meta, base + tabla};
+        Track& track = r->datos[t];
+        track.nombre = in.cadena();
+        track.resultado = leerResultado(in);
+        track.ranuras = in.varint();
+        track.procesos = in.varint();
+        track.extras = in.varint();
+        uint64_t inicioIndice = in.fijo<uint64_t>();
+        uint64_t inicioExtras = in.fijo<uint64_t>();
+        uint64_t inicioProcesos = in.fijo<uint64_t>();
+        if (!in.ok || track.ranuras > UINT64_MAX / 2 || track.procesos > tamano || track.extras > tamano) {
+            return nullptr;
+        }
+
+        uint64_t segmentos = (track.ranuras + RANURAS_SEGMENTO - 1) / RANURAS_SEGMENTO;
+        uint64_t bytesOffsetsExtras = (track.extras + 1) * sizeof(uint64_t);
+        uint64_t bytesOffsetsPid = (track.procesos + 1) * sizeof(uint64_t);
+        if (segmentos > tamano || !dentro(inicioIndice, (segmentos + 1) * sizeof(uint64_t)) ||
+            !dentro(inicioExtras, bytesOffsetsExtras) || !dentro(inicioProcesos, bytesOffsetsPid)) {
+            return nullptr;
+        }
+        track.indiceSegmentos = base + inicioIndice;
+
+        track.offsetsExtras = base + inicioExtras;
+        track.textoExtras = track.offsetsExtras + bytesOffsetsExtras;
+        if (!dentro(inicioExtras + bytesOffsetsExtras,
+                    leerFijo<uint64_t>(track.offsetsExtras + track.extras * sizeof(uint64_t)))) {
+            return nullptr;
+        }
+
+        track.offsetsPid = base + inicioProcesos;
+        track.textoPid = track.offsetsPid + bytesOffsetsPid;
+        uint64_t textoPid = leerFijo<uint64_t>(track.offsetsPid + track.procesos * sizeof(uint64_t));
+        uint64_t bytesColumnas = track.procesos * (COLUMNAS_PROCESO + 1) * sizeof(int32_t);
+        if (!dentro(inicioProcesos + bytesOffsetsPid, textoPid) ||
+            !dentro(inicioProcesos + bytesOffsetsPid + textoPid, bytesColumnas)) {
+            return nullptr;
+        }
+        track.columnas = track.textoPid + textoPid;
+        track.orden = track.columnas + track.procesos * COLUMNAS_PROCESO * sizeof(int32_t);
+    }
+    return r;
+}
+
+ArchivoResultados::~ArchivoResultados() {
+    if (base) {
+        ::munmap(const_cast<uint8_t*>(base), tamano);
+    }
+}
+
+HistorialGantt::Ranura ArchivoResultados::ranura(size_t t, size_t i) const {
+    const Track& track = datos[t];
+    size_t segmento = i / RANURAS_SEGMENTO;
+    if (segmento != track.segmento) {
+        decodificarSegmento(track, segmento);
+    }
+    size_t k = i % RANURAS_SEGMENTO;
+    return {track.corridas[track.corridaDe[k]], track.ciclos[k]};
+}
+
+void ArchivoResultados::decodificarSegmento(const Track& track, size_t segmento) const {
+    size_t ranuras = std::min(RANURAS_SEGMENTO, track.ranuras - segmento * RANURAS_SEGMENTO);
+    track.segmento = segmento;
+    track.corridas.clear();
+    track.corridaDe.clear();
+    track.ciclos.clear();
+
+    uint64_t inicio = leerFijo<uint64_t>(track.indiceSegmentos + segmento * sizeof(uint64_t));
+    uint64_t fin = leerFijo<uint64_t>(track.indiceSegmentos + (segmento + 1) * sizeof(uint64_t));
+    Lector in{base, base};
+    if (inicio <= fin && fin <= tamano) {
+        in = Lector{base + inicio, base + fin};
+    }
+
+    int64_t id = 0;
+    int64_t cicloEsperado = 0;
+    while (track.ciclos.size() < ranuras) {
+        id += in.entero();
+        uint64_t largo = in.varint() + 1;
+        int64_t ciclo = cicloEsperado + in.entero();
+        if (!in.ok || id < 0 || (uint64_t)id >= track.procesos + track.extras || largo > ranuras - track.ciclos.size()) {
+            break;
+        }
+        track.corridas.emplace_back(etiqueta(&track - datos.data(), (size_t)id));
+        for (uint64_t k = 0; k < largo; ++k) {
+            track.corridaDe.push_back((uint16_t)(track.corridas.size() - 1));
+            track.ciclos.push_back((int32_t)(ciclo + k));
+        }
+        cicloEsperado = ciclo + largo;
+    }
+
+    // Segmento dañado: lo que falte queda vacío en vez de leer fuera del archivo
+    if (track.ciclos.size() < ranuras) {
+        track.corridas.emplace_back();
+        track.corridaDe.resize(ranuras, (uint16_t)(track.corridas.size() - 1));
+        track.ciclos.resize(ranuras, 0);
+    }
+}
+
+// Texto k de una tabla offsets u64 x (n+1) | texto; vacío si está dañada
+std::string_view ArchivoResultados::texto(const uint8_t* offsets, const uint8_t* texto, size_t n, size_t k) {
+    uint64_t desde = leerFijo<uint64_t>(offsets + k * sizeof(uint64_t));
+    uint64_t hasta = leerFijo<uint64_t>(offsets + (k + 1) * sizeof(uint64_t));
+    uint64_t total = leerFijo<uint64_t>(offsets + n * sizeof(uint64_t));
+    if (desde > hasta || hasta > total) return {};
+    return std::string_view(reinterpret_cast<const char*>(texto) + desde, hasta - desde);
+}
+
+MetricasProceso ArchivoResultados::proceso(size_t t, size_t i) const {
+    const Track& track = datos[t];
+    MetricasProceso m;
+    m.pid = texto(track.offsetsPid, track.textoPid, track.procesos, i);
+    auto columna = [&](int c) {
+        return (int)leerFijo<int32_t>(track.columnas + (c * track.procesos + i) * sizeof(int32_t));
+    };
+    m.waiting_time = columna(0);
+    m.turnaround_time = columna(1);
+    m.completion_time = columna(2);
+    m.response_time = columna(3);
+    return m;
+}
+
+std::string_view ArchivoResultados::etiqueta(size_t t, size_t k) const {
+    const Track& track = datos[t];
+    if (k < track.procesos) return texto(track.offsetsPid, track.textoPid, track.procesos, k);
+    return texto(track.offsetsExtras, track.textoExtras, track.extras, k - track.procesos);
+}
+
+// Búsqueda binaria sobre la permutación de procesos ordenada por pid
+int ArchivoResultados::indiceProceso(size_t t, const std::string& pid) const {
+    const Track& track = datos[t];
+    auto enOrden = [&](size_t k) {
+        uint32_t i = leerFijo<uint32_t>(track.orden + k * sizeof(uint32_t));
+        return i < track.procesos ? (int)i : -1;
+    };
+    size_t bajo = 0, alto = track.procesos;
+    while (bajo < alto) {
+        size_t medio = bajo + (alto - bajo) / 2;
+        int i = enOrden(medio);
+        if (i >= 0 && texto(track.offsetsPid, track.textoPid, track.procesos, i) < pid) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    if (bajo == track.procesos) return -1;
+    int i = enOrden(bajo);
+    return i >= 0 && texto(track.offsetsPid, track.textoPid, track.procesos, i) == pid ? i : -1;
+}
+
+TrackResultados ArchivoResultados::track(size_t t) const {
+    std::shared_ptr<const ArchivoResultados> archivo = shared_from_this();
+    TrackResultados track;
+    track.nombre = datos[t].nombre;
+    track.resultado = datos[t].resultado;
+    track.ranuras = datos[t].ranuras;
+    track.ranura = [archivo, t](size_t i) { return archivo->ranura(t, i); };
+    track.procesos = datos[t].procesos;
+    track.proceso = [archivo, t](size_t i) { return archivo->proceso(t, i); };
+    return track;
+}
@@ -0,0 +1,118 @@
+#ifndef ARCHIVO_RESULTADOS_H
+#define ARCHIVO_RESULTADOS_H
+#include "historial_gantt.h"
+#include "scheduler.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Archivo binario de resultados de calendarización (.sres). Cada track
+// guarda su timeline en segmentos de HistorialGantt::RANURAS_POR_SEGMENTO
+// ranuras, codificados como corridas (etiqueta, largo, ciclo) en varint con
+// deltas, más un índice de segmentos; las métricas por proceso van en
+// columnas de ancho fijo. Al abrir, el archivo se mapea en memoria y solo se
+// decodifican las métricas generales: cada segmento se decodifica cuando se
+// pide una de sus ranuras, así que reabrir cuesta lo mismo para 1 000 que
+// para 100 millones de ciclos.
+
+struct MetricasProceso {
+    std::string_view pid;
+    int waiting_time = 0;
+    int turnaround_time = 0;
+    int completion_time = 0;
+    int response_time = 0;
+};
+
+// Lo que se guarda de un algoritmo. Las ranuras y los procesos se piden por
+// índice para escribir en streaming, sin copiar el timeline.
+struct TrackResultados {
+    std::string nombre;
+    ResultadoCompartido resultado;             // Su timeline no se usa
+    size_t ranuras = 0;
+    std::function<HistorialGantt::Ranura(size_t)> ranura;
+    size_t procesos = 0;
+    std::function<MetricasProceso(size_t)> proceso;
+};
+
+TrackResultados trackResultados(const std::string& nombre, const HistorialGantt& historial,
+                                ResultadoCompartido resultado, ProcesosCompartidos procesos);
+
+// Huella de procesos.txt (pid, llegada, ráfagas y prioridad) para saber si
+// unos resultados corresponden a la carga que está abierta
+uint64_t hashCarga(const std::vector<Proceso>& procesos);
+
+// false si no se pudo escribir el archivo
+bool guardarResultados(const std::string& archivo, uint64_t hashCarga, const std::vector<TrackResultados>& tracks);
+
+// Resultados abiertos desde disco. Las consultas leen directamente del
+// archivo mapeado; cada track conserva decodificado el último segmento que
+// se consultó, así que no es seguro usarlo desde varios hilos a la vez.
+class ArchivoResultados : public std::enable_shared_from_this<ArchivoResultados> {
+public:
+    // nullptr si el archivo no existe o no es un archivo de resultados válido
+    static std::shared_ptr<const ArchivoResultados> abrir(const std::string& archivo);
+    ~ArchivoResultados();
+
+    uint64_t hashCarga() const { return hash; }
+    size_t tracks() const { return datos.size(); }
+    const std::string& nombre(size_t t) const { return datos[t].nombre; }
+    ResultadoCompartido resultado(size_t t) const { return datos[t].resultado; }
+
+    size_t ranuras(size_t t) const { return datos[t].ranuras; }
+    // La referencia a contenido es válida hasta la siguiente consulta del
+    // mismo track en otro segmento
+    HistorialGantt::Ranura ranura(size_t t, size_t i) const;
+
+    size_t procesos(size_t t) const { return datos[t].procesos; }
+    MetricasProceso proceso(size_t t, size_t i) const;
+
+    // Contenidos posibles del timeline: los pids de los procesos, en orden,
+    // y luego los que no son un proceso (CS, IDLE)
+    size_t etiquetas(size_t t) const { return datos[t].procesos + datos[t].extras; }
+    std::string_view etiqueta(size_t t, size_t k) const;
+    // Posición del pid en la carga guardada, -1 si no es un proceso
+    int indiceProceso(size_t t, const std::string& pid) const;
+
+    // El track vuelve a guardarse tal cual; mantiene vivo el archivo
+    TrackResultados track(size_t t) const;
+
+    ArchivoResultados(const ArchivoResultados&) = delete;
+    ArchivoResultados& operator=(const ArchivoResultados&) = delete;
+
+private:
+    ArchivoResultados() = default;
+
+    struct Track {
+        std::string nombre;
+        ResultadoCompartido resultado;
+        size_t ranuras = 0;
+        size_t procesos = 0;
+        size_t extras = 0;
+        const uint8_t* indiceSegmentos = nullptr;  // uint64 x (segmentos + 1)
+        const uint8_t* offsetsExtras = nullptr;    // uint64 x (extras + 1)
+        const uint8_t* textoExtras = nullptr;
+        const uint8_t* offsetsPid = nullptr;       // uint64 x (procesos + 1)
+        const uint8_t* textoPid = nullptr;
+        const uint8_t* columnas = nullptr;         // int32 x procesos, cuatro columnas seguidas
+        const uint8_t* orden = nullptr;            // uint32 x procesos, índices ordenados por pid
+
+        // Último segmento decodificado: una cadena por corrida
+        mutable size_t segmento = SIZE_MAX;
+        mutable std::vector<std::string> corridas;
+        mutable std::vector<uint16_t> corridaDe;
+        mutable std::vector<int32_t> ciclos;
+    };
+
+    void decodificarSegmento(const Track& track, size_t segmento) const;
+    static std::string_view texto(const uint8_t* offsets, const uint8_t* texto, size_t n, size_t k);
+
+    const uint8_t* base = nullptr;
+    size_t tamano = 0;
+    uint64_t hash = 0;
+    std::vector<Track> datos;
+};
+
+#endif
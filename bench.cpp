@@ -0,0 +1,287 @@
+// bench.cpp
+// Benchmark de los algoritmos de calendarización y de los simuladores de
+// sincronización sobre cargas generadas. Se compila sin wxWidgets:
+//
+//   make bench                                   (corre con valores por defecto)
+//   ./scheduler_bench --max 10000000 --out bench_baseline.tsv
+//   ./scheduler_bench --compare bench_baseline.tsv
+//
+// Los resultados se escriben siempre en formato TSV (bench_resultados.tsv por
+// defecto) para poder compararlos contra corridas posteriores.
+//
+// Cada tamaño se omite si, extrapolando la corrida anterior del mismo motor,
+// excedería el presupuesto de tiempo o de memoria.
+#include "scheduler.h"
+#include "instrumentacion.h"
+#include "generador_carga.h"
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+// ---------------------------------------------------------------------------
+// Conteo de asignaciones: cada bloque guarda su tamaño en un encabezado
+// ---------------------------------------------------------------------------
+namespace {
+std::atomic<long long> asignaciones{0};
+std::atomic<long long> bytesVivos{0};
+std::atomic<long long> picoBytes{0};
+
+constexpr size_t ENCABEZADO = alignof(std::max_align_t);
+
+void* asignar(size_t n) {
+    void* base = std::malloc(n + ENCABEZADO);
+    if (!base) throw std::bad_alloc();
+    *static_cast<size_t*>(base) = n;
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    long long vivos = bytesVivos.fetch_add(n, std::memory_order_relaxed) + n;
+    long long pico = picoBytes.load(std::memory_order_relaxed);
+    while (vivos > pico && !picoBytes.compare_exchange_weak(pico, vivos, std::memory_order_relaxed)) {
+    }
+    return static_cast<char*>(base) + ENCABEZADO;
+}
+
+void liberar(void* p) {
+    if (!p) return;
+    void* base = static_cast<char*>(p) - ENCABEZADO;
+    bytesVivos.fetch_sub(*static_cast<size_t*>(base), std::memory_order_relaxed);
+    std::free(base);
+}
+}
+
+void* operator new(size_t n) { return asignar(n); }
+void* operator new[](size_t n) { return asignar(n); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept {
+    try { return asignar(n); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t n, const std::nothrow_t&) noexcept {
+    try { return asignar(n); } catch (...) { return nullptr; }
+}
+void operator delete(void* p) noexcept { liberar(p); }
+void operator delete[](void* p) noexcept { liberar(p); }
+void operator delete(void* p, size_t) noexcept { liberar(p); }
+void operator delete[](void* p, size_t) noexcept { liberar(p); }
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Medición
+// ---------------------------------------------------------------------------
+struct Medicion {
+    std::string motor;
+    long long n = 0;
+    long long ciclos = 0;
+    double segundos = 0;
+    long long picoBytes = 0;
+    long long asignaciones = 0;
+
+    double nsPorProceso() const { return n ? segundos * 1e9 / n : 0; }
+    double nsPorCiclo() const { return ciclos ? segundos * 1e9 / ciclos : 0; }
+};
+
+template <typename F>
+Medicion medir(const std::string& motor, long long n, F&& correr) {
+    Medicion m;
+    m.motor = motor;
+    m.n = n;
+    long long asignacionesAntes = asignaciones.load();
+    picoBytes.store(bytesVivos.load());
+    long long vivosAntes = bytesVivos.load();
+
+    auto inicio = std::chrono::steady_clock::now();
+    {
+        INSTR_FASE(motor.c_str()); // motor vive hasta el final de main
+        m.ciclos = correr();
+    }
+    m.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    m.picoBytes = picoBytes.load() - vivosAntes;
+    m.asignaciones = asignaciones.load() - asignacionesAntes;
+    return m;
+}
+
+struct Opciones {
+    long long maximo = 10000000;
+    double presupuestoSegundos = 20;
+    long long presupuestoBytes = 2LL << 30;
+    std::string salida = "bench_resultados.tsv";
+    std::string comparar;
+    std::string traza;
+    int quantum = 4;
+    bool sinTimeline = false;
+    bool soloMetricas = false;
+};
+
+void imprimir(const Medicion& m) {
+    std::printf("%-12s %10lld %12.1f %12.2f %12.1f %12lld\n", m.motor.c_str(), m.n,
+                m.nsPorProceso(), m.nsPorCiclo(), m.picoBytes / 1048576.0, m.asignaciones);
+    std::fflush(stdout);
+}
+
+void escribirResultados(const std::string& archivo, const std::vector<Medicion>& mediciones) {
+    std::ofstream out(archivo);
+    out << "motor\tn\tciclos\tns_por_proceso\tns_por_ciclo\tpico_bytes\tasignaciones\n";
+    for (const auto& m : mediciones) {
+        out << m.motor << '\t' << m.n << '\t' << m.ciclos << '\t' << m.nsPorProceso() << '\t'
+            << m.nsPorCiclo() << '\t' << m.picoBytes << '\t' << m.asignaciones << '\n';
+    }
+}
+
+void compararConBaseline(const std::string& archivo, const std::vector<Medicion>& mediciones) {
+    std::ifstream in(archivo);
+    if (!in) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", archivo.c_str());
+        return;
+    }
+
+    std::map<std::pair<std::string, long long>, std::pair<double, long long>> previas;
+    std::string linea;
+    std::getline(in, linea); // encabezado
+    while (std::getline(in, linea)) {
+        std::stringstream ss(linea);
+        std::string motor;
+        long long n, ciclos, pico, asign;
+        double nsProc, nsCiclo;
+        if (std::getline(ss, motor, '\t') && ss >> n >> ciclos >> nsProc >> nsCiclo >> pico >> asign) {
+            previas[{motor, n}] = {nsProc, asign};
+        }
+    }
+
+    std::printf("\nComparacion contra %s\n", archivo.c_str());
+    std::printf("%-12s %10s %12s %12s %10s\n", "motor", "n", "ns/proc", "antes", "cambio");
+    for (const auto& m : mediciones) {
+        auto it = previas.find({m.motor, m.n});
+        if (it == previas.end()) continue;
+        double antes = it->second.first;
+        std::printf("%-12s %10lld %12.1f %12.1f %+9.1f%%\n", m.motor.c_str(), m.n,
+                    m.nsPorProceso(), antes, antes > 0 ? (m.nsPorProceso() / antes - 1) * 100 : 0.0);
+    }
+}
+
+Opciones leerOpciones(int argc, char** argv) {
+    Opciones op;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hayValor = i + 1 < argc;
+        if (arg == "--max" && hayValor) op.maximo = std::atoll(argv[++i]);
+        else if (arg == "--budget" && hayValor) op.presupuestoSegundos = std::atof(argv[++i]);
+        else if (arg == "--mem" && hayValor) op.presupuestoBytes = std::atoll(argv[++i]) << 20;
+        else if (arg == "--out" && hayValor) op.salida = argv[++i];
+        else if (arg == "--compare" && hayValor) op.comparar = argv[++i];
+        else if (arg == "--quantum" && hayValor) op.quantum = std::atoi(argv[++i]);
+        else if (arg == "--trace" && hayValor) op.traza = argv[++i];
+        else if (arg == "--sin-timeline") op.sinTimeline = true;
+        else if (arg == "--solo-metricas") op.soloMetricas = true;
+        else {
+            std::fprintf(stderr, "Uso: %s [--max N] [--budget seg] [--mem MiB] [--out archivo] "
+                                 "[--compare archivo] [--quantum q] [--trace archivo] [--sin-timeline] "
+                                 "[--solo-metricas]\n", argv[0]);
+            std::exit(1);
+        }
+    }
+    return op;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Opciones op = leerOpciones(argc, argv);
+    SimulationConfig config;
+    config.guardarTimeline = !op.sinTimeline;
+    config.soloMetricas = op.soloMetricas;
+
+    // Cada motor devuelve el numero de ciclos simulados
+    using Motor = std::function<long long(std::vector<Proceso>&)>;
+    std::vector<std::pair<std::string, Motor>> motores = {
+        {"FIFO", [&](std::vector<Proceso>& p) { return (long long)fifo(p, nullptr, config).ultimoCiclo; }},
+        {"SJF", [&](std::vector<Proceso>& p) { return (long long)sjf(p, nullptr, config).ultimoCiclo; }},
+        {"SRT", [&](std::vector<Proceso>& p) { return (long long)srt(p, nullptr, config).ultimoCiclo; }},
+        {"RoundRobin", [&](std::vector<Proceso>& p) {
+            return (long long)roundRobin(p, op.quantum, nullptr, config).ultimoCiclo; }},
+        {"Priority", [&](std::vector<Proceso>& p) { return (long long)priority(p, nullptr, config).ultimoCiclo; }},
+        {"Lottery", [&](std::vector<Proceso>& p) {
+            return (long long)lottery(p, op.quantum, nullptr, config).ultimoCiclo; }},
+        {"Stride", [&](std::vector<Proceso>& p) {
+            return (long long)stride(p, op.quantum, nullptr, config).ultimoCiclo; }},
+    };
+
+    std::vector<Medicion> mediciones;
+    std::printf("%-12s %10s %12s %12s %12s %12s\n", "motor", "n", "ns/proc", "ns/ciclo", "pico MiB", "asignaciones");
+
+    // Extrapola la siguiente corrida a partir de las dos anteriores
+    auto excedePresupuesto = [&op](const std::vector<Medicion>& previas) {
+        if (previas.empty()) return false;
+        const Medicion& ultima = previas.back();
+        double exponente = 1.0;
+        if (previas.size() >= 2 && previas[previas.size() - 2].segundos > 1e-3) {
+            exponente = std::max(1.0, std::log10(ultima.segundos / previas[previas.size() - 2].segundos));
+        }
+        return ultima.segundos * std::pow(10.0, exponente) > op.presupuestoSegundos ||
+               ultima.picoBytes * 10 > op.presupuestoBytes;
+    };
+
+    for (const auto& [nombre, motor] : motores) {
+        std::vector<Medicion> previas;
+        for (long long n = 1000; n <= op.maximo; n *= 10) {
+            if (excedePresupuesto(previas)) {
+                std::printf("%-12s %10lld   omitido (excede presupuesto)\n", nombre.c_str(), n);
+                break;
+            }
+            std::vector<Proceso> carga = generarProcesos((int)n, 42);
+            Medicion m = medir(nombre, n, [&]() { return motor(carga); });
+            imprimir(m);
+            previas.push_back(m);
+            mediciones.push_back(m);
+        }
+    }
+
+    using MotorSync = void (*)(std::vector<Proceso>&, std::map<std::string, Recurso>&,
+                               std::vector<Accion>&, UpdateCallback, const SimulationConfig&);
+    std::vector<std::pair<std::string, MotorSync>> sincronizacion = {
+        {"Mutex", simularMutex},
+        {"Semaforo", simularSemaforo},
+    };
+
+    for (const auto& [nombre, motor] : sincronizacion) {
+        std::vector<Medicion> previas;
+        for (long long n = 1000; n <= op.maximo; n *= 10) {
+            if (excedePresupuesto(previas)) {
+                std::printf("%-12s %10lld   omitido (excede presupuesto)\n", nombre.c_str(), n);
+                break;
+            }
+            std::vector<Proceso> procesos;
+            std::map<std::string, Recurso> recursos;
+            std::vector<Accion> acciones = generarAcciones((int)n, recursos, 42);
+            Medicion m = medir(nombre, n, [&]() {
+                motor(procesos, recursos, acciones, nullptr, config);
+                return (long long)acciones.back().ciclo + 6;
+            });
+            imprimir(m);
+            previas.push_back(m);
+            mediciones.push_back(m);
+        }
+    }
+
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    std::printf("\nRSS maximo del proceso: %.1f MiB\n", uso.ru_maxrss / 1024.0);
+
+    if (!op.comparar.empty()) {
+        compararConBaseline(op.comparar, mediciones);
+    }
+    escribirResultados(op.salida, mediciones);
+#ifdef SCHED_INSTRUMENTACION
+    if (!op.traza.empty() && instr::exportarTrazaChrome(op.traza)) {
+        std::printf("Traza de instrumentacion escrita en %s\n", op.traza.c_str());
+    }
+#endif
+    std::printf("Resultados escritos en %s\n", op.salida.c_str());
+    return 0;
+}
@@ -0,0 +1,347 @@
+#include "calendarizador_online.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <tuple>
+
+bool LectorProcesos::operator()(Proceso& p) {
+    while (std::getline(entrada, linea)) {
+        if (linea.find_first_not_of(" \t\r") == std::string::npos) continue;
+        try {
+            // Una ráfaga de 0 ciclos nunca terminaría
+            if (leerProceso(linea, p) && p.burst_time > 0) return true;
+        } catch (const std::exception&) {
+        }
+        ignoradas++;
+    }
+    return false;
+}
+
+CalendarizadorOnline::CalendarizadorOnline(FuenteProcesos fuente, const SimulationConfig& config)
+    : fuente(std::move(fuente)), config(config) {
+    this->config.guardarTimeline = false;
+    this->config.checkpoints = nullptr; // No hay carga completa que reproducir
+}
+
+const SimulationResult& CalendarizadorOnline::resultado() {
+    calcularMetricas(result);
+    return result;
+}
+
+bool CalendarizadorOnline::leerSiguiente() {
+    if (hayPendiente) return true;
+    if (fuenteAgotada) return false;
+    if (!fuente(pendiente)) {
+        fuenteAgotada = true;
+        return false;
+    }
+    hayPendiente = true;
+    if (pendiente.arrival_time < tiempo) {
+        pendiente.arrival_time = tiempo;
+        tardias++;
+    }
+    return true;
+}
+
+int CalendarizadorOnline::ocupar() {
+    Proceso& p = pendiente;
+    p.remaining_time = p.burst_time;
+    p.start_time = -1;
+    p.terminado = false;
+    p.en_cola = false;
+    p.fase = 0;
+    p.en_es = false;
+    for (const auto& r : p.es) {
+        while ((int)dispositivos.size() <= r.dispositivo) {
+            dispositivos.emplace_back(&arena);
+            result.ciclosOcupadosES.push_back(0);
+        }
+    }
+
+    int idx;
+    if (!libres.empty()) {
+        idx = libres.back();
+        libres.pop_back();
+        std::swap(procesos[idx], p); // La ranura devuelve sus buffers a pendiente
+    } else {
+        idx = procesos.size();
+        procesos.push_back(std::move(p));
+        secuencia.push_back(0);
+    }
+    secuencia[idx] = siguienteSecuencia++;
+    hayPendiente = false;
+    return idx;
+}
+
+// La ranura conserva sus datos hasta que la ocupe la siguiente llegada
+void CalendarizadorOnline::retirar(int idx) {
+    libres.push_back(idx);
+}
+
+void CalendarizadorOnline::enviarAES(int idx) {
+    Proceso& p = procesos[idx];
+    const RafagaES& r = p.es[p.fase];
+    DispositivoES& d = dispositivos[r.dispositivo];
+    if (d.cola.empty()) {
+        d.restante = r.duracion;
+    }
+    d.cola.push_back(idx);
+    p.en_es = true;
+}
+
+void CalendarizadorOnline::avanzarES() {
+    volvieronDeES.clear();
+    for (size_t d = 0; d < dispositivos.size(); ++d) {
+        DispositivoES& disp = dispositivos[d];
+        if (disp.cola.empty()) continue;
+
+        result.ciclosOcupadosES[d]++;
+        if (--disp.restante > 0) continue;
+
+        int idx = disp.cola.front();
+        disp.cola.pop_front();
+        Proceso& p = procesos[idx];
+        p.en_es = false;
+        p.fase++;
+        p.remaining_time = rafagaActual(p);
+        volvieronDeES.push_back(idx);
+
+        if (!disp.cola.empty()) {
+            const Proceso& q = procesos[disp.cola.front()];
+            disp.restante = q.es[q.fase].duracion;
+        }
+    }
+}
+
+namespace {
+
+// Colas de listos. A diferencia de las políticas de motor.h no recorren la
+// carga: cada una guarda sólo los procesos que ya llegaron, así que elegir
+// cuesta O(1) u O(log n) en los procesos vivos.
+
+// Gana el que quedó listo primero: una llegada o un regreso de E/S
+struct ListosFIFO {
+    std::deque<int> llegadas;
+    std::deque<std::pair<int, int>> regresos; // (proceso, ciclo en que volvió)
+
+    void llegada(const std::vector<Proceso>&, unsigned long long, int idx) { llegadas.push_back(idx); }
+    void regreso(const std::vector<Proceso>&, unsigned long long, int idx, int tiempo) {
+        regresos.push_back({idx, tiempo});
+    }
+    void expropiado(const std::vector<Proceso>&, unsigned long long, int) {}
+    bool expropiar(int ciclosEnCpu) const { return false; }
+
+    int tomar(const std::vector<Proceso>& procesos) {
+        if (!regresos.empty() &&
+            (llegadas.empty() || regresos.front().second < procesos[llegadas.front()].arrival_time)) {
+            int idx = regresos.front().first;
+            regresos.pop_front();
+            return idx;
+        }
+        if (llegadas.empty()) return -1;
+        int idx = llegadas.front();
+        llegadas.pop_front();
+        return idx;
+    }
+    size_t size() const { return llegadas.size() + regresos.size(); }
+};
+
+// Las llegadas del mismo ciclo entran antes que el expropiado y que el que
+// vuelve de E/S, igual que en SeleccionRoundRobin
+struct ListosRoundRobin {
+    int quantum = 2;
+    std::deque<int> cola;
+
+    void llegada(const std::vector<Proceso>&, unsigned long long, int idx) { cola.push_back(idx); }
+    void regreso(const std::vector<Proceso>&, unsigned long long, int idx, int) { cola.push_back(idx); }
+    void expropiado(const std::vector<Proceso>&, unsigned long long, int idx) { cola.push_back(idx); }
+    bool expropiar(int ciclosEnCpu) const { return ciclosEnCpu >= quantum; }
+
+    int tomar(const std::vector<Proceso>&) {
+        if (cola.empty()) return -1;
+        int idx = cola.front();
+        cola.pop_front();
+        return idx;
+    }
+    size_t size() const { return cola.size(); }
+};
+
+// Montículo por (clave, orden de llegada): el desempate por llegada es el
+// mismo que el "primer índice" de los recorridos de SJF, SRT y Priority
+template <class Clave, bool Expropia>
+struct ListosMonticulo {
+    using Entrada = std::tuple<int, unsigned long long, int>;
+    std::priority_queue<Entrada, std::vector<Entrada>, std::greater<Entrada>> heap;
+
+    void llegada(const std::vector<Proceso>& procesos, unsigned long long seq, int idx) {
+        heap.emplace(Clave()(procesos[idx]), seq, idx);
+    }
+    void regreso(const std::vector<Proceso>& procesos, unsigned long long seq, int idx, int) {
+        llegada(procesos, seq, idx);
+    }
+    void expropiado(const std::vector<Proceso>& procesos, unsigned long long seq, int idx) {
+        llegada(procesos, seq, idx);
+    }
+    bool expropiar(int ciclosEnCpu) const { return Expropia; }
+
+    int tomar(const std::vector<Proceso>&) {
+        if (heap.empty()) return -1;
+        int idx = std::get<2>(heap.top());
+        heap.pop();
+        return idx;
+    }
+    size_t size() const { return heap.size(); }
+};
+
+struct ClaveRafaga {
+    int operator()(const Proceso& p) const { return rafagaActual(p); }
+};
+struct ClaveRestante {
+    int operator()(const Proceso& p) const { return p.remaining_time; }
+};
+struct ClavePrioridad {
+    int operator()(const Proceso& p) const { return p.priority; }
+};
+
+using ListosSJF = ListosMonticulo<ClaveRafaga, false>;
+using ListosSRT = ListosMonticulo<ClaveRestante, true>;
+using ListosPriority = ListosMonticulo<ClavePrioridad, false>;
+
+template <class Listos>
+class CalendarizadorPoliticas final : public CalendarizadorOnline {
+public:
+    CalendarizadorPoliticas(FuenteProcesos fuente, const SimulationConfig& config, Listos listos = {})
+        : CalendarizadorOnline(std::move(fuente), config), listos(std::move(listos)) {}
+
+    bool step() override;
+
+private:
+    // Pasa a la cola de listos todo lo que ya llegó
+    void admitir() {
+        while (leerSiguiente() && pendiente.arrival_time <= tiempo) {
+            int idx = ocupar();
+            listos.llegada(procesos, secuencia[idx], idx);
+        }
+    }
+
+    // Las referencias a procesos no sobreviven: admitir() puede hacer crecer
+    // el vector de ranuras
+    void emitir(const std::string& contenido) {
+        anotarCiclo(contenido, tiempo, result, config);
+        if (observador) observador(contenido, tiempo);
+        tiempo++;
+
+        if (!dispositivos.empty()) {
+            avanzarES();
+            for (int idx : volvieronDeES) {
+                admitir();
+                listos.regreso(procesos, secuencia[idx], idx, tiempo);
+            }
+        }
+    }
+
+    Listos listos;
+};
+
+template <class Listos>
+bool CalendarizadorPoliticas<Listos>::step() {
+    // Cada step emite un ciclo; el siguiente ya no cabría en el reloj
+    if (tiempo == LIMITE_CICLOS) {
+        enLimite = true;
+        calcularMetricas(result);
+        return false;
+    }
+    admitir();
+    if (flujoTerminado() && vivos() == 0) {
+        calcularMetricas(result);
+        return false;
+    }
+
+    if (csPendiente > 0) {
+        csPendiente--;
+        emitir("CS");
+        return true;
+    }
+
+    if (actual == -1) {
+        int idx;
+        {
+            INSTR_ACUMULAR(NS_SELECCION);
+            idx = listos.tomar(procesos);
+        }
+        if (idx == -1) {
+            emitir("IDLE");
+            return true;
+        }
+        if (config.traza) {
+            config.traza->colaListos(tiempo, listos.size());
+        }
+
+        actual = idx;
+        ciclosEnCpu = 0;
+        const std::string& pid = procesos[idx].pid;
+        if (!ultimo.empty() && ultimo != pid) {
+            result.contextSwitches++;
+            csPendiente = config.contextSwitch;
+        }
+        ultimo = pid;
+
+        if (csPendiente > 0) {
+            csPendiente--;
+            emitir("CS");
+            return true;
+        }
+    }
+
+    if (procesos[actual].start_time == -1) {
+        procesos[actual].start_time = tiempo;
+    }
+    emitir(procesos[actual].pid);
+    procesos[actual].remaining_time--;
+    ciclosEnCpu++;
+    admitir();
+
+    Proceso& p = procesos[actual];
+    if (p.remaining_time == 0 && p.fase < (int)p.es.size()) {
+        enviarAES(actual);
+        actual = -1;
+    } else if (p.remaining_time == 0) {
+        p.completion_time = tiempo;
+        PoliticaBase().calcularTiempos(p);
+        p.terminado = true;
+        registrarTerminado(result, p);
+        completados++;
+        retirar(actual);
+        actual = -1;
+        if (alTerminar) alTerminar(p);
+    } else if (listos.expropiar(ciclosEnCpu)) {
+        listos.expropiado(procesos, secuencia[actual], actual);
+        actual = -1;
+    }
+    return true;
+}
+
+}
+
+std::unique_ptr<CalendarizadorOnline> crearCalendarizadorOnline(Algoritmo algoritmo, FuenteProcesos fuente,
+                                                                const SimulationConfig& config, int quantum) {
+    switch (algoritmo) {
+        case Algoritmo::FIFO:
+            return std::make_unique<CalendarizadorPoliticas<ListosFIFO>>(std::move(fuente), config);
+        case Algoritmo::SJF:
+            return std::make_unique<CalendarizadorPoliticas<ListosSJF>>(std::move(fuente), config);
+        case Algoritmo::SRT:
+            return std::make_unique<CalendarizadorPoliticas<ListosSRT>>(std::move(fuente), config);
+        case Algoritmo::ROUND_ROBIN:
+            return std::make_unique<CalendarizadorPoliticas<ListosRoundRobin>>(
+                std::move(fuente), config, ListosRoundRobin{quantum});
+        case Algoritmo::PRIORITY:
+            return std::make_unique<CalendarizadorPoliticas<ListosPriority>>(std::move(fuente), config);
+        case Algoritmo::LOTTERY:
+        case Algoritmo::STRIDE:
+            break; // Sólo en los motores de motor.h
+    }
+    return nullptr;
+}
@@ -0,0 +1,128 @@
+#ifndef CALENDARIZADOR_ONLINE_H
+#define CALENDARIZADOR_ONLINE_H
+#include "motor.h"
+#include <climits>
+#include <functional>
+#include <istream>
+#include <memory>
+
+// Calendarización en línea: los procesos no se conocen por adelantado sino
+// que se leen de un flujo (stdin, un FIFO) conforme el reloj simulado llega a
+// su arrival_time. Cada proceso que termina se retira del motor y se entrega
+// al callback alTerminar, así que la memoria depende de los procesos vivos y
+// no de cuántos han pasado por el flujo.
+//
+// Los ciclos emitidos son los mismos que los de los motores de motor.h sobre
+// la carga completa, con dos diferencias:
+//   - El flujo debe venir ordenado por arrival_time. Un proceso con un
+//     arrival_time ya pasado entra con el ciclo en que se leyó y se cuenta en
+//     llegadasTardias().
+//   - Priority sólo considera procesos que ya llegaron y calcula los tiempos
+//     desde la llegada, como las demás políticas. Con todas las llegadas en 0
+//     coincide con el motor por lotes.
+//
+// El reloj y las llegadas son int, como en Proceso y SimulationResult. La
+// corrida se detiene al llegar a LIMITE_CICLOS (INT_MAX, unos 2.1e9 ciclos):
+// step() devuelve false aunque queden procesos y limiteAlcanzado() lo
+// indica. Los procesos que no terminaron no cuentan en resultado().
+
+// Devuelve false cuando el flujo terminó. Puede bloquear esperando datos.
+using FuenteProcesos = std::function<bool(Proceso&)>;
+
+// Lee líneas de procesos.txt de un flujo. Las líneas que no se pueden leer
+// se saltan y se cuentan.
+class LectorProcesos {
+public:
+    explicit LectorProcesos(std::istream& entrada) : entrada(entrada) {}
+    bool operator()(Proceso& p);
+    long long lineasIgnoradas() const { return ignoradas; }
+
+private:
+    std::istream& entrada;
+    std::string linea;
+    long long ignoradas = 0;
+};
+
+class CalendarizadorOnline {
+public:
+    using AlTerminar = std::function<void(const Proceso&)>;
+
+    static constexpr int LIMITE_CICLOS = INT_MAX;
+
+    virtual ~CalendarizadorOnline() = default;
+
+    // Avanza un ciclo. Devuelve false cuando el flujo terminó y ya no quedan
+    // procesos vivos, o cuando el reloj llegó a LIMITE_CICLOS.
+    virtual bool step() = 0;
+    void runToEnd() {
+        while (!cancelado() && step()) {
+        }
+    }
+
+    void setObservador(UpdateCallback cb) { observador = std::move(cb); }
+    void setAlTerminar(AlTerminar cb) { alTerminar = std::move(cb); }
+
+    int cicloActual() const { return tiempo; }
+    // Procesos que ya llegaron y todavía no terminan
+    size_t vivos() const { return procesos.size() - libres.size(); }
+    long long terminados() const { return completados; }
+    long long llegadasTardias() const { return tardias; }
+    // El reloj ya no puede avanzar; la corrida terminó sin vaciar el flujo
+    bool limiteAlcanzado() const { return enLimite; }
+    // Acumulado desde el inicio; las métricas se recalculan en cada consulta
+    const SimulationResult& resultado();
+
+protected:
+    CalendarizadorOnline(FuenteProcesos fuente, const SimulationConfig& config);
+
+    bool cancelado() const { return config.cancelacion && config.cancelacion->cancelado(); }
+
+    // Deja en pendiente el siguiente proceso del flujo; false si ya no hay.
+    // Sólo bloquea si no hay uno leído por adelantado, es decir, cuando hace
+    // falta saber si el siguiente llega en este ciclo.
+    bool leerSiguiente();
+    bool flujoTerminado() const { return !hayPendiente && fuenteAgotada; }
+
+    // Mueve pendiente a una ranura libre y devuelve su índice
+    int ocupar();
+    void retirar(int idx);
+    void enviarAES(int idx);
+    // Como EstadoMotor::avanzarES: deja en volvieronDeES los que terminaron
+    void avanzarES();
+
+    FuenteProcesos fuente;
+    SimulationConfig config;
+    SimulationResult result;
+    UpdateCallback observador;
+    AlTerminar alTerminar;
+
+    // Ranuras de procesos vivos; las de los terminados se reutilizan
+    std::vector<Proceso> procesos;
+    std::vector<unsigned long long> secuencia; // Orden de llegada, para desempatar
+    std::vector<int> libres;
+    unsigned long long siguienteSecuencia = 0;
+
+    Proceso pendiente;           // Leído por adelantado, aún no llega
+    bool hayPendiente = false;
+    bool fuenteAgotada = false;
+
+    int tiempo = 0;
+    bool enLimite = false;
+    long long completados = 0;
+    long long tardias = 0;
+    int actual = -1;
+    int ciclosEnCpu = 0;
+    int csPendiente = 0;
+    std::string ultimo;
+
+    std::pmr::unsynchronized_pool_resource arena;
+    std::vector<DispositivoES> dispositivos;
+    std::vector<int> volvieronDeES;
+};
+
+// nullptr para LOTTERY y STRIDE. quantum sólo se usa con ROUND_ROBIN. El timeline de config no se guarda:
+// crecería con el flujo; quien quiera los ciclos los recibe por el observador.
+std::unique_ptr<CalendarizadorOnline> crearCalendarizadorOnline(Algoritmo algoritmo, FuenteProcesos fuente,
+                                                                const SimulationConfig& config, int quantum = 2);
+
+#endif
@@ -0,0 +1,68 @@
+#include "cancelacion.h"
+#include <algorithm>
+
+void TokenCancelacion::cancelar() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        cancelado_.store(true, std::memory_order_relaxed);
+    }
+    cv.notify_all();
+}
+
+bool TokenCancelacion::esperar(std::chrono::nanoseconds duracion) const {
+    std::unique_lock<std::mutex> lock(m);
+    return cv.wait_for(lock, duracion, [this] { return cancelado(); });
+}
+
+EjecutorTrabajos::~EjecutorTrabajos() {
+    cancelarTodo();
+    esperarTodo();
+}
+
+std::shared_ptr<TokenCancelacion> EjecutorTrabajos::lanzar(Trabajo trabajo) {
+    auto token = std::make_shared<TokenCancelacion>();
+    auto terminado = std::make_shared<std::atomic<bool>>(false);
+
+    std::lock_guard<std::mutex> lock(m);
+    recolectar();
+    hilos.push_back({std::thread([trabajo = std::move(trabajo), token, terminado]() {
+                         trabajo(token);
+                         terminado->store(true, std::memory_order_release);
+                     }),
+                     token, terminado});
+    return token;
+}
+
+void EjecutorTrabajos::cancelarTodo() {
+    std::lock_guard<std::mutex> lock(m);
+    for (auto& h : hilos) {
+        h.token->cancelar();
+    }
+}
+
+void EjecutorTrabajos::esperarTodo() {
+    // Se unen fuera del candado: un trabajo puede lanzar o cancelar otros
+    std::vector<Hilo> pendientes;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        pendientes.swap(hilos);
+    }
+    for (auto& h : pendientes) {
+        if (h.hilo.joinable()) h.hilo.join();
+    }
+}
+
+bool EjecutorTrabajos::ocupado() const {
+    std::lock_guard<std::mutex> lock(m);
+    return std::any_of(hilos.begin(), hilos.end(),
+                       [](const Hilo& h) { return !h.terminado->load(std::memory_order_acquire); });
+}
+
+void EjecutorTrabajos::recolectar() {
+    auto fin = std::partition(hilos.begin(), hilos.end(),
+                              [](const Hilo& h) { return !h.terminado->load(std::memory_order_acquire); });
+    for (auto it = fin; it != hilos.end(); ++it) {
+        it->hilo.join();
+    }
+    hilos.erase(fin, hilos.end());
+}
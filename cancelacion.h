@@ -0,0 +1,65 @@
+#ifndef CANCELACION_H
+#define CANCELACION_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Cancelación cooperativa. Los motores consultan cancelado() una vez por
+// ciclo simulado: una lectura relajada de un atómico que nadie más escribe,
+// sin candados ni llamadas indirectas en el ciclo caliente. Las pausas de
+// animación usan esperar(), que despierta en cuanto se cancela.
+class TokenCancelacion {
+public:
+    bool cancelado() const { return cancelado_.load(std::memory_order_relaxed); }
+    void cancelar();
+    // Duerme hasta `duracion` o hasta la cancelación; true si se canceló
+    bool esperar(std::chrono::nanoseconds duracion) const;
+
+private:
+    std::atomic<bool> cancelado_{false};
+    mutable std::mutex m;
+    mutable std::condition_variable cv;
+};
+
+// Dueño de los hilos de simulación de la GUI. Cada trabajo recibe su propio
+// token; cancelarTodo() los avisa a todos sin bloquear y esperarTodo() los
+// une (con los motores cooperando, en milisegundos). El destructor cancela y
+// espera, así que ningún hilo sobrevive al panel que lo lanzó. El token se
+// entrega compartido para que lo que el trabajo encole en la GUI (CallAfter)
+// pueda consultarlo aunque el hilo ya haya terminado.
+class EjecutorTrabajos {
+public:
+    using Token = std::shared_ptr<const TokenCancelacion>;
+    using Trabajo = std::function<void(Token)>;
+
+    EjecutorTrabajos() = default;
+    EjecutorTrabajos(const EjecutorTrabajos&) = delete;
+    EjecutorTrabajos& operator=(const EjecutorTrabajos&) = delete;
+    ~EjecutorTrabajos();
+
+    // Corre el trabajo en un hilo nuevo y devuelve su token
+    std::shared_ptr<TokenCancelacion> lanzar(Trabajo trabajo);
+    void cancelarTodo();
+    void esperarTodo();
+    bool ocupado() const;
+
+private:
+    struct Hilo {
+        std::thread hilo;
+        std::shared_ptr<TokenCancelacion> token;
+        std::shared_ptr<std::atomic<bool>> terminado;
+    };
+
+    // Une los hilos que ya terminaron; requiere el candado
+    void recolectar();
+
+    mutable std::mutex m;
+    std::vector<Hilo> hilos;
+};
+
+#endif
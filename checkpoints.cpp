@@ -0,0 +1,157 @@
+#include "motor.h"
+#include <algorithm>
+
+size_t Checkpoint::bytes() const {
+    return sizeof(Checkpoint) + ultimo.capacity() +
+           terminados.capacity() * sizeof(terminados[0]) +
+           vivos.capacity() * sizeof(EstadoProceso) +
+           extra.capacity() * sizeof(int) +
+           colasES.capacity() * sizeof(int);
+}
+
+std::vector<int> EstadoMotor::listosPorLlegada() const {
+    std::vector<int> cola;
+    for (int i = 0; i < (int)procesos.size(); ++i) {
+        if (i != actual && !procesos[i].terminado && !procesos[i].en_es && procesos[i].arrival_time <= tiempo) {
+            cola.push_back(i);
+        }
+    }
+    return cola;
+}
+
+Checkpoint EstadoMotor::capturar() const {
+    Checkpoint c;
+    c.tiempo = tiempo;
+    c.completados = completados;
+    c.actual = actual;
+    c.ciclosEnCpu = ciclosEnCpu;
+    c.csPendiente = csPendiente;
+    c.ultimo = ultimo;
+
+    for (int i = 0; i < (int)procesos.size(); ++i) {
+        const Proceso& p = procesos[i];
+        if (p.terminado) {
+            if (!c.terminados.empty() && c.terminados.back().second == i) {
+                c.terminados.back().second++;
+            } else {
+                c.terminados.push_back({i, i + 1});
+            }
+        } else if (p.remaining_time != p.burst_time || p.start_time != -1 || p.en_cola || p.fase != 0) {
+            c.vivos.push_back({i, p.remaining_time, p.start_time, p.en_cola, p.fase, p.en_es});
+        }
+    }
+
+    for (const auto& d : dispositivos) {
+        c.colasES.push_back(d.restante);
+        c.colasES.push_back((int)d.cola.size());
+        c.colasES.insert(c.colasES.end(), d.cola.begin(), d.cola.end());
+    }
+
+    c.terminados.shrink_to_fit();
+    c.vivos.shrink_to_fit();
+    return c;
+}
+
+void EstadoMotor::restaurar(const Checkpoint& c) {
+    tiempo = c.tiempo;
+    completados = c.completados;
+    actual = c.actual;
+    ciclosEnCpu = c.ciclosEnCpu;
+    csPendiente = c.csPendiente;
+    ultimo = c.ultimo;
+
+    for (auto& p : procesos) {
+        p.remaining_time = p.burst_time;
+        p.start_time = -1;
+        p.terminado = false;
+        p.en_cola = false;
+        p.fase = 0;
+        p.en_es = false;
+    }
+    for (const auto& [inicio, fin] : c.terminados) {
+        for (int i = inicio; i < fin; ++i) {
+            procesos[i].terminado = true;
+            procesos[i].remaining_time = 0;
+        }
+    }
+    for (const auto& e : c.vivos) {
+        Proceso& p = procesos[e.idx];
+        p.remaining_time = e.remaining_time;
+        p.start_time = e.start_time;
+        p.en_cola = e.en_cola;
+        p.fase = e.fase;
+        p.en_es = e.en_es;
+    }
+
+    size_t pos = 0;
+    for (auto& d : dispositivos) {
+        d.cola.clear();
+        d.restante = 0;
+        if (pos + 2 > c.colasES.size()) continue;
+        d.restante = c.colasES[pos];
+        int longitud = c.colasES[pos + 1];
+        d.cola.assign(c.colasES.begin() + pos + 2, c.colasES.begin() + pos + 2 + longitud);
+        pos += 2 + longitud;
+    }
+}
+
+HistorialCheckpoints::HistorialCheckpoints(int intervalo, size_t presupuestoBytes)
+    : intervalo_(std::max(1, intervalo)), presupuesto(presupuestoBytes) {}
+
+void HistorialCheckpoints::agregar(Checkpoint c) {
+    int t = c.tiempo;
+    bytes_ += c.bytes();
+    checkpoints.push_back(std::move(c));
+    proximo = t - t % intervalo_ + intervalo_;
+
+    if (bytes_ > presupuesto && checkpoints.size() > 1) {
+        recortar();
+    }
+}
+
+// Conserva los checkpoints alineados al nuevo intervalo (el doble del actual)
+void HistorialCheckpoints::recortar() {
+    intervalo_ *= 2;
+    std::vector<Checkpoint> conservados;
+    bytes_ = 0;
+    for (auto& c : checkpoints) {
+        if (c.tiempo % intervalo_ == 0 || c.tiempo == 0) {
+            bytes_ += c.bytes();
+            conservados.push_back(std::move(c));
+        }
+    }
+    checkpoints = std::move(conservados);
+    int ultimoTiempo = checkpoints.empty() ? 0 : checkpoints.back().tiempo;
+    proximo = ultimoTiempo - ultimoTiempo % intervalo_ + intervalo_;
+}
+
+const Checkpoint* HistorialCheckpoints::buscar(int ciclo) const {
+    auto it = std::upper_bound(checkpoints.begin(), checkpoints.end(), ciclo,
+        [](int t, const Checkpoint& c) { return t < c.tiempo; });
+    if (it == checkpoints.begin()) return nullptr;
+    return &*(it - 1);
+}
+
+ReproductorCheckpoints::ReproductorCheckpoints(Algoritmo algoritmo, std::vector<Proceso> procesos, int quantum,
+                                               const SimulationConfig& config,
+                                               std::shared_ptr<const HistorialCheckpoints> historial)
+    : historial(std::move(historial)) {
+    SimulationConfig silencioso = config;
+    silencioso.guardarTimeline = false;
+    silencioso.traza = nullptr;
+    silencioso.checkpoints = nullptr;
+    motor = crearMotor(algoritmo, std::move(procesos), silencioso, quantum);
+}
+
+const MotorCalendarizacion& ReproductorCheckpoints::irA(int ciclo) {
+    // Si el motor ya está entre el checkpoint más cercano y el destino basta con avanzar
+    const Checkpoint* c = historial->buscar(ciclo);
+    if (c && (motor->cicloActual() > ciclo || motor->cicloActual() < c->tiempo)) {
+        motor->restaurar(*c);
+    } else if (!c && motor->cicloActual() > ciclo) {
+        Checkpoint inicial;
+        motor->restaurar(inicial);
+    }
+    motor->runUntil(ciclo);
+    return *motor;
+}
@@ -1,28 +1,52 @@
 #include "scheduler.h"
+#include "instrumentacion.h"
+#include "cancelacion.h"
+#include "traza_simulacion.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+
+bool leerProceso(const std::string& linea, Proceso& p) {
+    std::stringstream ss(linea);
+    std::string pid, bt_str, at_str, prio_str;
+    if (!(std::getline(ss, pid, ',') && std::getline(ss, bt_str, ',') &&
+          std::getline(ss, at_str, ',') && std::getline(ss, prio_str, ','))) {
+        return false;
+    }
+    
+    // Eliminar espacios en blanco
+    pid.erase(0, pid.find_first_not_of(" \t"));
+    pid.erase(pid.find_last_not_of(" \t") + 1);
+    
+    p = Proceso();
+    p.pid = pid;
+    p.burst_time = std::stoi(bt_str);
+    p.arrival_time = std::stoi(at_str);
+    p.priority = std::stoi(prio_str);
+    p.remaining_time = p.burst_time;
+    
+    // Pares opcionales "D<n>:<duración>, <ráfaga de CPU>" después de la prioridad
+    std::string es, cpu;
+    while (std::getline(ss, es, ',') && std::getline(ss, cpu, ',')) {
+        size_t dosPuntos = es.find(':');
+        size_t d = es.find_first_of("Dd");
+        if (dosPuntos == std::string::npos || d == std::string::npos || d > dosPuntos) break;
+        p.es.push_back({std::max(0, std::stoi(es.substr(d + 1, dosPuntos - d - 1))),
+                        std::max(1, std::stoi(es.substr(dosPuntos + 1))),
+                        std::max(1, std::stoi(cpu))});
+    }
+    return true;
+}
 
 std::vector<Proceso> leerProcesosDesdeArchivo(const std::string& filename) {
+    INSTR_FASE("cargar_procesos");
     std::vector<Proceso> procesos;
     std::ifstream archivo(filename);
     std::string linea;
+    Proceso p;
 
     while (std::getline(archivo, linea)) {
-        std::stringstream ss(linea);
-        std::string pid, bt_str, at_str, prio_str;
-        if (std::getline(ss, pid, ',') && std::getline(ss, bt_str, ',') &&
-            std::getline(ss, at_str, ',') && std::getline(ss, prio_str, ',')) {
-            
-            // Eliminar espacios en blanco
-            pid.erase(0, pid.find_first_not_of(" \t"));
-            pid.erase(pid.find_last_not_of(" \t") + 1);
-            
-            Proceso p;
-            p.pid = pid;
-            p.burst_time = std::stoi(bt_str);
-            p.arrival_time = std::stoi(at_str);
-            p.priority = std::stoi(prio_str);
-            p.remaining_time = p.burst_time;
+        if (leerProceso(linea, p)) {
             procesos.push_back(p);
         }
     }
@@ -31,6 +55,7 @@ std::vector<Proceso> leerProcesosDesdeArchivo(const std::string& filename) {
 }
 
 std::map<std::string, Recurso> leerRecursosDesdeArchivo(const std::string& filename) {
+    INSTR_FASE("cargar_recursos");
     std::map<std::string, Recurso> recursos;
     std::ifstream file(filename);
     std::string linea;
@@ -54,6 +79,7 @@ std::map<std::string, Recurso> leerRecursosDesdeArchivo(const std::string& filen
 }
 
 std::vector<Accion> leerAccionesDesdeArchivo(const std::string& filename) {
+    INSTR_FASE("cargar_acciones");
     std::vector<Accion> acciones;
     std::ifstream file(filename);
     std::string linea;
@@ -76,3 +102,80 @@ std::vector<Accion> leerAccionesDesdeArchivo(const std::string& filename) {
     }
     return acciones;
 }
+
+int cpuTotal(const Proceso& p) {
+    int total = p.burst_time;
+    for (const auto& r : p.es) total += r.cpu;
+    return total;
+}
+
+int esTotal(const Proceso& p) {
+    int total = 0;
+    for (const auto& r : p.es) total += r.duracion;
+    return total;
+}
+
+// Registra un ciclo simulado en el timeline, la traza y la GUI
+void anotarCiclo(const std::string& contenido, int tiempo, SimulationResult& result,
+                 const SimulationConfig& config) {
+    if (config.guardarTimeline && !config.soloMetricas) {
+        result.timeline.push_back({contenido, tiempo});
+        INSTR_CONTAR(ADICIONES_TIMELINE);
+    }
+    if (config.traza) {
+        config.traza->ciclo(contenido, tiempo);
+    }
+}
+
+void registrarCiclo(const std::string& contenido, int tiempo, SimulationResult& result,
+                    const SimulationConfig& config, UpdateCallback& updateGUI) {
+    anotarCiclo(contenido, tiempo, result, config);
+    if (updateGUI) {
+        INSTR_CONTAR(LLAMADAS_CALLBACK);
+        updateGUI(contenido, tiempo);
+    }
+}
+
+// Se llama una vez por proceso al terminar, sin guardar tiempos individuales
+void registrarTerminado(SimulationResult& result, const Proceso& p) {
+    result.waiting.agregar(p.waiting_time);
+    result.turnaround.agregar(p.turnaround_time);
+    result.response.agregar(p.response_time);
+    result.ciclosOcupados += cpuTotal(p);
+    result.primerCiclo = std::min(result.primerCiclo, std::min(p.arrival_time, p.start_time));
+    result.ultimoCiclo = std::max(result.ultimoCiclo, p.completion_time);
+}
+
+void calcularMetricas(SimulationResult& result) {
+    INSTR_FASE("metricas");
+    long long n = result.waiting.cantidad();
+    if (n == 0) {
+        result.avgWaitingTime = 0;
+        return;
+    }
+
+    result.avgWaitingTime = result.waiting.promedio();
+    result.avgTurnaroundTime = result.turnaround.promedio();
+    result.avgResponseTime = result.response.promedio();
+    result.makespan = result.ultimoCiclo - result.primerCiclo;
+    if (result.makespan > 0) {
+        result.cpuUtilization = (double)result.ciclosOcupados / result.makespan;
+        result.throughput = (double)n / result.makespan;
+        result.utilizacionES.clear();
+        for (long long ocupados : result.ciclosOcupadosES) {
+            result.utilizacionES.push_back((double)ocupados / result.makespan);
+        }
+    }
+}
+
+bool corridaCancelada(const SimulationConfig& config) {
+    return config.cancelacion && config.cancelacion->cancelado();
+}
+
+bool pausaAnimacion(const SimulationConfig& config, int ms) {
+    if (config.cancelacion) {
+        return config.cancelacion->esperar(std::chrono::milliseconds(ms));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    return false;
+}
@@ -0,0 +1,213 @@
+#include "contencion_real.h"
+#include "cancelacion.h"
+#include "sincronizacion.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+using Reloj = std::chrono::steady_clock;
+
+// C++17 no trae std::counting_semaphore
+class SemaforoConteo {
+public:
+    void iniciar(int n) { disponibles = n; }
+    bool intentar() {
+        std::lock_guard<std::mutex> lock(m);
+        if (disponibles == 0) return false;
+        disponibles--;
+        return true;
+    }
+    void adquirir() {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return disponibles > 0; });
+        disponibles--;
+    }
+    void liberar() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            disponibles++;
+        }
+        cv.notify_one();
+    }
+
+private:
+    std::mutex m;
+    std::condition_variable cv;
+    int disponibles = 1;
+};
+
+// Un semáforo en 0 se trata como 1: con hilos reales nadie lo liberaría
+int capacidad(const std::map<std::string, Recurso>& recursos, const std::string& nombre, bool mutex) {
+    if (mutex) return 1;
+    auto it = recursos.find(nombre);
+    return it != recursos.end() ? std::max(1, it->second.contador_inicial) : 1;
+}
+
+// Índices de las acciones en el orden en que el modelo las procesa: por
+// ciclo y, dentro del ciclo, en el orden del archivo
+std::vector<size_t> ordenPorCiclo(const std::vector<Accion>& acciones) {
+    std::vector<size_t> orden(acciones.size());
+    std::iota(orden.begin(), orden.end(), 0);
+    std::stable_sort(orden.begin(), orden.end(),
+                     [&](size_t a, size_t b) { return acciones[a].ciclo < acciones[b].ciclo; });
+    return orden;
+}
+
+// Duerme hasta `instante`; con token, la cancelación lo despierta
+bool dormirHasta(Reloj::time_point instante, const TokenCancelacion* cancelacion) {
+    if (!cancelacion) {
+        std::this_thread::sleep_until(instante);
+        return false;
+    }
+    auto falta = instante - Reloj::now();
+    return falta > Reloj::duration::zero() ? cancelacion->esperar(falta) : cancelacion->cancelado();
+}
+
+}
+
+std::vector<bool> predecirEsperas(const std::map<std::string, Recurso>& recursos,
+                                  const std::vector<Accion>& acciones, const OpcionesContencion& opciones) {
+    OpcionesSync sync;
+    sync.mutex = opciones.mutex;
+    sync.ciclosRetencion = opciones.ciclosRetencion;
+    sync.capacidadMinima = 1;
+    std::vector<bool> espera(acciones.size(), false);
+    for (const EventoSync& e : simularSyncParticionado(recursos, acciones, sync).eventos) {
+        espera[e.accion] = !e.accedio;
+    }
+    return espera;
+}
+
+ResultadoContencion medirContencionReal(const std::map<std::string, Recurso>& recursos,
+                                        const std::vector<Accion>& acciones, const OpcionesContencion& opciones,
+                                        const TokenCancelacion* cancelacion) {
+    ResultadoContencion resultado;
+    resultado.mediciones.resize(acciones.size());
+    if (acciones.empty()) return resultado;
+
+    std::vector<bool> espera = predecirEsperas(recursos, acciones, opciones);
+
+    // Un cerrojo real por recurso nombrado en las acciones
+    std::map<std::string, int> indiceRecurso;
+    std::vector<int> recursoDe(acciones.size());
+    for (size_t i = 0; i < acciones.size(); ++i) {
+        recursoDe[i] = indiceRecurso.emplace(acciones[i].recurso, (int)indiceRecurso.size()).first->second;
+    }
+    std::unique_ptr<std::mutex[]> mutexes;
+    std::unique_ptr<SemaforoConteo[]> semaforos;
+    if (opciones.mutex) {
+        mutexes.reset(new std::mutex[indiceRecurso.size()]);
+    } else {
+        semaforos.reset(new SemaforoConteo[indiceRecurso.size()]);
+        for (const auto& [nombre, idx] : indiceRecurso) semaforos[idx].iniciar(capacidad(recursos, nombre, false));
+    }
+
+    // El guion de cada hilo: sus acciones en orden de ciclo
+    std::map<std::string, std::vector<size_t>> guiones;
+    for (size_t i : ordenPorCiclo(acciones)) guiones[acciones[i].pid].push_back(i);
+    resultado.hilos = guiones.size();
+
+    const auto ciclo = std::chrono::microseconds(std::max(1, opciones.usPorCiclo));
+    const auto retencion = ciclo * std::max(1, opciones.ciclosRetencion);
+    std::vector<Reloj::time_point> pedidos(acciones.size()), liberados(acciones.size());
+    std::vector<char> completada(acciones.size(), 0); // Cada hilo escribe sólo sus índices
+
+    // Ningún hilo arranca hasta que están creados todos; si crear uno falla,
+    // los que ya existen salen sin tocar los cerrojos
+    std::mutex mArranque;
+    std::condition_variable cvArranque;
+    int arranque = 0; // 1: todos creados, -1: abortado
+    Reloj::time_point t0;
+    auto hilo = [&](const std::vector<size_t>& guion) {
+        {
+            std::unique_lock<std::mutex> lock(mArranque);
+            cvArranque.wait(lock, [&] { return arranque != 0; });
+            if (arranque < 0) return;
+        }
+        for (size_t i : guion) {
+            const Accion& a = acciones[i];
+            if (dormirHasta(t0 + ciclo * a.ciclo, cancelacion)) return;
+
+            int r = recursoDe[i];
+            Reloj::time_point pedido = Reloj::now();
+            bool inmediato = opciones.mutex ? mutexes[r].try_lock() : semaforos[r].intentar();
+            if (!inmediato) {
+                if (opciones.mutex) mutexes[r].lock();
+                else semaforos[r].adquirir();
+            }
+            Reloj::time_point obtenido = Reloj::now();
+            dormirHasta(obtenido + retencion, cancelacion);
+            if (opciones.mutex) mutexes[r].unlock();
+            else semaforos[r].liberar();
+
+            MedicionAccion& m = resultado.mediciones[i];
+            m.espero = !inmediato;
+            m.latenciaNs = std::chrono::duration_cast<std::chrono::nanoseconds>(obtenido - pedido).count();
+            m.retencionNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Reloj::now() - obtenido).count();
+            pedidos[i] = pedido;
+            liberados[i] = obtenido + std::chrono::nanoseconds(m.retencionNs);
+            completada[i] = 1;
+        }
+    };
+    std::vector<std::thread> hilos;
+    hilos.reserve(guiones.size());
+    try {
+        for (const auto& entrada : guiones) {
+            hilos.emplace_back(hilo, std::cref(entrada.second));
+        }
+    } catch (const std::system_error& e) {
+        resultado.error = "No se pudieron crear " + std::to_string(guiones.size()) + " hilos (se crearon " +
+                          std::to_string(hilos.size()) + "): " + e.what();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mArranque);
+        arranque = resultado.error.empty() ? 1 : -1;
+        // Margen para que todos despierten antes del ciclo 0
+        t0 = Reloj::now() + std::chrono::milliseconds(20);
+    }
+    cvArranque.notify_all();
+    for (auto& t : hilos) t.join();
+    if (!resultado.error.empty()) return resultado;
+
+    resultado.cancelado = cancelacion && cancelacion->cancelado();
+    Reloj::time_point inicio = Reloj::time_point::max(), fin = Reloj::time_point::min();
+    long long retenidoNs = 0, adquisiciones = 0, accesosModelo = 0;
+    int primerCiclo = INT_MAX, ultimoCiclo = INT_MIN;
+    for (size_t i = 0; i < acciones.size(); ++i) {
+        MedicionAccion& m = resultado.mediciones[i];
+        m.esperaPredicha = espera[i];
+        resultado.esperasPredichas += espera[i];
+        accesosModelo += !espera[i];
+        primerCiclo = std::min(primerCiclo, acciones[i].ciclo);
+        ultimoCiclo = std::max(ultimoCiclo, acciones[i].ciclo);
+        if (!completada[i]) continue;
+
+        adquisiciones++;
+        resultado.esperasReales += m.espero;
+        resultado.coincidencias += m.espero == m.esperaPredicha;
+        resultado.latenciaNs.agregar((int)std::min<long long>(m.latenciaNs, INT_MAX));
+        retenidoNs += m.retencionNs;
+        inicio = std::min(inicio, pedidos[i]);
+        fin = std::max(fin, liberados[i]);
+    }
+
+    if (adquisiciones > 0) {
+        resultado.duracionUs = std::chrono::duration<double, std::micro>(fin - inicio).count();
+        resultado.retencionMediaUs = retenidoNs / 1000.0 / adquisiciones;
+        if (resultado.duracionUs > 0) {
+            resultado.adquisicionesPorSegundo = adquisiciones / (resultado.duracionUs / 1e6);
+        }
+    }
+    // El modelo ocupa desde el primer ciclo con acciones hasta que termina la última retención
+    double duracionModeloUs = (double)(ultimoCiclo - primerCiclo + std::max(1, opciones.ciclosRetencion)) *
+                              std::max(1, opciones.usPorCiclo);
+    resultado.adquisicionesPorSegundoModelo = accesosModelo / (duracionModeloUs / 1e6);
+    return resultado;
+}
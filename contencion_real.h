@@ -0,0 +1,50 @@
+#ifndef CONTENCION_REAL_H
+#define CONTENCION_REAL_H
+#include "scheduler.h"
+
+class TokenCancelacion;
+
+// Reproduce acciones.txt sobre hilos reales del sistema operativo, uno por
+// proceso, que compiten por std::mutex (modo mutex) o por semáforos
+// contadores del tamaño de recursos.txt. Cada acción se lanza en
+// t0 + ciclo * usPorCiclo, retiene el recurso ciclosRetencion ciclos de
+// tiempo real y se mide con steady_clock. El resultado se compara contra la
+// predicción del modelo por ciclos: una acción que el modelo marca WAITING
+// debería ser una que el hilo no pudo tomar al primer intento.
+struct OpcionesContencion {
+    bool mutex = true;            // false: semáforos contadores
+    int usPorCiclo = 1000;        // Tiempo real de un ciclo simulado
+    int ciclosRetencion = 3;      // Ciclos que el recurso queda tomado (los del panel de sincronización)
+};
+
+struct MedicionAccion {
+    bool esperaPredicha = false;  // El modelo la marca WAITING
+    bool espero = false;          // El hilo no obtuvo el recurso al primer intento
+    long long latenciaNs = 0;     // Desde que el hilo pide el recurso hasta obtenerlo
+    long long retencionNs = 0;    // Desde que lo obtiene hasta liberarlo
+};
+
+struct ResultadoContencion {
+    std::vector<MedicionAccion> mediciones; // Una por acción, en el orden de acciones
+    int hilos = 0;
+    bool cancelado = false;
+    double duracionUs = 0;                  // Primera petición a última liberación
+    SketchCuantiles latenciaNs;
+    double retencionMediaUs = 0;
+    double adquisicionesPorSegundo = 0;
+    double adquisicionesPorSegundoModelo = 0; // ACCESSED del modelo / duración simulada en tiempo real
+    int esperasPredichas = 0;
+    int esperasReales = 0;
+    int coincidencias = 0;                  // Acciones donde modelo y medición coinciden
+    std::string error;                      // No se pudieron crear los hilos; no hay mediciones
+};
+
+// Clasificación del modelo por ciclos: true si la acción queda en WAITING
+std::vector<bool> predecirEsperas(const std::map<std::string, Recurso>& recursos,
+                                  const std::vector<Accion>& acciones, const OpcionesContencion& opciones);
+
+ResultadoContencion medirContencionReal(const std::map<std::string, Recurso>& recursos,
+                                        const std::vector<Accion>& acciones, const OpcionesContencion& opciones,
+                                        const TokenCancelacion* cancelacion = nullptr);
+
+#endif
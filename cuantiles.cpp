@@ -0,0 +1,42 @@
+#include "scheduler.h"
+#include <algorithm>
+
+// Los valores menores a EXACTOS tienen cubeta propia. Por encima, cada
+// potencia de dos se divide en SUBCUBETAS partes iguales.
+int SketchCuantiles::indice(int valor) {
+    if (valor < EXACTOS) return valor;
+    int exponente = 31 - __builtin_clz((unsigned)valor);
+    int mantisa = (valor >> (exponente - 5)) - SUBCUBETAS;
+    return EXACTOS + (exponente - 6) * SUBCUBETAS + mantisa;
+}
+
+double SketchCuantiles::valorRepresentativo(int indice) {
+    if (indice < EXACTOS) return indice;
+    int exponente = 6 + (indice - EXACTOS) / SUBCUBETAS;
+    int mantisa = (indice - EXACTOS) % SUBCUBETAS + SUBCUBETAS;
+    double ancho = (double)(1LL << (exponente - 5));
+    return mantisa * ancho + ancho / 2;
+}
+
+void SketchCuantiles::agregar(int valor) {
+    valor = std::max(valor, 0);
+    cubetas_[indice(valor)]++;
+    cantidad_++;
+    suma_ += valor;
+    maximo_ = std::max(maximo_, valor);
+}
+
+double SketchCuantiles::cuantil(double q) const {
+    if (cantidad_ == 0) return 0;
+
+    // Rango del elemento buscado (1..cantidad)
+    long long objetivo = std::max(1LL, (long long)(q * cantidad_ + 0.999999));
+    long long acumulado = 0;
+    for (int i = 0; i < NUM_CUBETAS; ++i) {
+        acumulado += cubetas_[i];
+        if (acumulado >= objetivo) {
+            return std::min(valorRepresentativo(i), (double)maximo_);
+        }
+    }
+    return maximo_;
+}
@@ -0,0 +1,663 @@
+#include "exportar_gantt.h"
+#include "instrumentacion.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+ColorRGB colorProceso(size_t i) {
+    static const ColorRGB predefinidos[] = {
+        {255, 100, 100},  // Rojo claro
+        {100, 255, 100},  // Verde claro
+        {100, 100, 255},  // Azul claro
+        {255, 255, 100},  // Amarillo
+        {255, 100, 255},  // Magenta
+        {100, 255, 255},  // Cyan
+        {255, 180, 100},  // Naranja
+        {180, 100, 255},  // Púrpura
+        {255, 180, 180},  // Rosa claro
+        {180, 255, 180}   // Verde menta
+    };
+    if (i < sizeof(predefinidos) / sizeof(predefinidos[0])) {
+        return predefinidos[i];
+    }
+    return {(uint8_t)(100 + ((i * 67) % 156)), (uint8_t)(100 + ((i * 89) % 156)), (uint8_t)(100 + ((i * 113) % 156))};
+}
+
+ColoresProceso asignarColores(const std::vector<Proceso>& procesos) {
+    ColoresProceso colores;
+    for (size_t i = 0; i < procesos.size(); ++i) {
+        colores[procesos[i].pid] = colorProceso(i);
+    }
+    return colores;
+}
+
+std::string resumenMetricas(const SimulationResult& result) {
+    char texto[128];
+    std::snprintf(texto, sizeof(texto), "Avg WT: %.2f | Avg TAT: %.2f | CS: %d", result.avgWaitingTime,
+                  result.avgTurnaroundTime, result.contextSwitches);
+    return texto;
+}
+
+TrackGantt trackDesdeHistorial(const std::string& nombre, const HistorialGantt& historial,
+                               const std::string& metricas) {
+    TrackGantt track;
+    track.nombre = nombre;
+    track.metricas = metricas;
+    track.ranuras = historial.size();
+    track.ranura = [&historial](size_t i) { return historial.en(i); };
+    return track;
+}
+
+TrackGantt trackDesdeTimeline(const std::string& nombre, const std::vector<std::pair<std::string, int>>& timeline,
+                              const std::string& metricas) {
+    TrackGantt track;
+    track.nombre = nombre;
+    track.metricas = metricas;
+    track.ranuras = timeline.size();
+    track.ranura = [&timeline](size_t i) { return HistorialGantt::Ranura{timeline[i].first, timeline[i].second}; };
+    return track;
+}
+
+namespace {
+
+const ColorRGB NEGRO{0, 0, 0};
+const ColorRGB BLANCO{255, 255, 255};
+const ColorRGB GRIS_TEXTO{100, 100, 100};
+const ColorRGB SIN_COLOR{200, 255, 200};     // Proceso sin color asignado
+
+// Geometría común a SVG y PNG, la misma de GanttPanel::OnPaint
+struct Geometria {
+    const OpcionesExportacion& op;
+    size_t tracks;
+    size_t maxRanuras;
+
+    static constexpr int MARGEN_IZQUIERDO = 150;  // Etiquetas
+    static constexpr int SEPARACION = 30;
+
+    int ancho() const { return MARGEN_IZQUIERDO + (int)maxRanuras * op.anchoBloque + 50; }
+    int alto() const { return 50 + (int)tracks * op.altoTrack + 60; }
+    int yTrack(size_t t) const { return 50 + (int)t * op.altoTrack; }
+    int xRanura(size_t i) const { return MARGEN_IZQUIERDO + (int)i * op.anchoBloque; }
+};
+
+Geometria medir(const std::vector<TrackGantt>& tracks, const OpcionesExportacion& opciones) {
+    size_t maxRanuras = 0;
+    for (const auto& t : tracks) maxRanuras = std::max(maxRanuras, t.ranuras);
+    return {opciones, tracks.size(), maxRanuras};
+}
+
+enum class TipoRanura { IDLE, CS, ESPERA, PROCESO };
+
+TipoRanura tipoRanura(const std::string& contenido) {
+    if (contenido == "CPU IDLE" || contenido == "IDLE") return TipoRanura::IDLE;
+    if (contenido == "CS") return TipoRanura::CS;
+    if (contenido.find("WAITING") != std::string::npos) return TipoRanura::ESPERA;
+    return TipoRanura::PROCESO;
+}
+
+ColorRGB colorDe(const ColoresProceso& colores, const std::string& pid) {
+    auto it = colores.find(pid);
+    return it != colores.end() ? it->second : SIN_COLOR;
+}
+
+// ---------------------------------------------------------------------------
+// SVG
+// ---------------------------------------------------------------------------
+std::string escaparXML(const std::string& s) {
+    std::string r;
+    r.reserve(s.size());
+    for (char c : s) {
+        switch (c) {
+        case '&': r += "&amp;"; break;
+        case '<': r += "&lt;"; break;
+        case '>': r += "&gt;"; break;
+        case '"': r += "&quot;"; break;
+        default: r += c;
+        }
+    }
+    return r;
+}
+
+std::string hex(ColorRGB c) {
+    char texto[8];
+    std::snprintf(texto, sizeof(texto), "#%02x%02x%02x", c.r, c.g, c.b);
+    return texto;
+}
+
+// ---------------------------------------------------------------------------
+// PNG
+// ---------------------------------------------------------------------------
+
+// Fuente de mapa de bits 5x7: cada fila es un byte con el bit 4 a la izquierda
+struct Glifo {
+    char c;
+    uint8_t filas[7];
+};
+
+const Glifo FUENTE[] = {
+    {' ', {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {'!', {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}},
+    {'#', {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}},
+    {'%', {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}},
+    {'\'', {0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}},
+    {'(', {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}},
+    {')', {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}},
+    {'*', {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}},
+    {'+', {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},
+    {',', {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}},
+    {'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}},
+    {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+    {'/', {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}},
+    {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+    {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+    {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+    {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+    {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+    {'<', {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}},
+    {'=', {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}},
+    {'>', {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}},
+    {'?', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}},
+    {'A', {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+    {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+    {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+    {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},
+    {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},
+    {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+    {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+    {'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},
+    {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+    {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+    {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+    {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+    {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+    {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},
+    {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+    {'Y', {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}},
+    {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+    {'[', {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}},
+    {']', {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}},
+    {'_', {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}},
+    {'|', {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+};
+
+const uint8_t* glifo(uint32_t c) {
+    static const std::array<const uint8_t*, 128> tabla = [] {
+        std::array<const uint8_t*, 128> t{};
+        for (const Glifo& g : FUENTE) t[(unsigned char)g.c] = g.filas;
+        return t;
+    }();
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    const uint8_t* g = c < 128 ? tabla[c] : nullptr;
+    return g ? g : tabla['?'];
+}
+
+// Decodifica UTF-8; las vocales acentuadas y la eñe se dibujan sin tilde
+std::vector<uint32_t> caracteres(const std::string& s) {
+    std::vector<uint32_t> r;
+    for (size_t i = 0; i < s.size(); ++i) {
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            r.push_back(c);
+            continue;
+        }
+        if (c == 0xC3 && i + 1 < s.size()) {
+            unsigned char d = (unsigned char)s[++i] | 0x20; // Minúscula
+            r.push_back(d >= 0xA0 && d <= 0xA5 ? 'A' : d >= 0xA8 && d <= 0xAB ? 'E' : d >= 0xAC && d <= 0xAF ? 'I'
+                        : d >= 0xB2 && d <= 0xB6 ? 'O' : d >= 0xB9 && d <= 0xBC ? 'U' : d == 0xB1 ? 'N' : '?');
+            continue;
+        }
+        while (i + 1 < s.size() && ((unsigned char)s[i + 1] & 0xC0) == 0x80) ++i;
+        r.push_back('?');
+    }
+    return r;
+}
+
+// Franja [x0, x0 + ancho) del Gantt completo, en RGB
+class Lienzo {
+public:
+    Lienzo(int x0, int ancho, int alto) : x0(x0), ancho(ancho), alto(alto), pixeles((size_t)ancho * alto * 3, 255) {}
+
+    void punto(int x, int y, ColorRGB c) {
+        x -= x0;
+        if (x < 0 || x >= ancho || y < 0 || y >= alto) return;
+        uint8_t* p = &pixeles[((size_t)y * ancho + x) * 3];
+        p[0] = c.r;
+        p[1] = c.g;
+        p[2] = c.b;
+    }
+
+    void rectangulo(int x, int y, int w, int h, ColorRGB c) {
+        int desde = std::max(x, x0) - x0, hasta = std::min(x + w, x0 + ancho) - x0;
+        if (desde >= hasta) return;
+        for (int fy = std::max(0, y); fy < std::min(y + h, alto); ++fy) {
+            uint8_t* p = &pixeles[((size_t)fy * ancho + desde) * 3];
+            for (int fx = desde; fx < hasta; ++fx, p += 3) {
+                p[0] = c.r;
+                p[1] = c.g;
+                p[2] = c.b;
+            }
+        }
+    }
+
+    // Borde hacia adentro; punteado alterna 2 píxeles sí y 2 no
+    void borde(int x, int y, int w, int h, int grosor, ColorRGB c, bool punteado = false) {
+        auto trazo = [&](int px, int py, int paso) {
+            if (!punteado || (paso / 2) % 2 == 0) punto(px, py, c);
+        };
+        for (int g = 0; g < grosor; ++g) {
+            for (int i = 0; i < w; ++i) {
+                trazo(x + i, y + g, i);
+                trazo(x + i, y + h - 1 - g, i);
+            }
+            for (int i = 0; i < h; ++i) {
+                trazo(x + g, y + i, i);
+                trazo(x + w - 1 - g, y + i, i);
+            }
+        }
+    }
+
+    void trama(int x, int y, int w, int h, ColorRGB c) {
+        for (int fy = y; fy < y + h; ++fy) {
+            for (int fx = std::max(x, x0); fx < std::min(x + w, x0 + ancho); ++fx) {
+                if ((fx + fy) % 8 == 0) punto(fx, fy, c);
+            }
+        }
+    }
+
+    void lineaHorizontal(int y, ColorRGB c) { rectangulo(x0, y, ancho, 1, c); }
+
+    static int anchoTexto(const std::string& s, int escala) {
+        size_t n = caracteres(s).size();
+        return n ? (int)n * 6 * escala - escala : 0;
+    }
+
+    void texto(int x, int y, const std::string& s, ColorRGB c, int escala = 1, bool negrita = false) {
+        if (x > x0 + ancho || x + anchoTexto(s, escala) + 1 < x0) return;
+        for (uint32_t ch : caracteres(s)) {
+            const uint8_t* g = glifo(ch);
+            for (int fila = 0; fila < 7; ++fila) {
+                for (int col = 0; col < 5; ++col) {
+                    if (!(g[fila] & (0x10 >> col))) continue;
+                    rectangulo(x + col * escala, y + fila * escala, escala + negrita, escala, c);
+                }
+            }
+            x += 6 * escala;
+        }
+    }
+
+    const uint8_t* fila(int y) const { return &pixeles[(size_t)y * ancho * 3]; }
+    int anchoPx() const { return ancho; }
+    int altoPx() const { return alto; }
+
+private:
+    int x0, ancho, alto;
+    std::vector<uint8_t> pixeles;
+};
+
+void dibujarTesela(Lienzo& lienzo, int x0, const std::vector<TrackGantt>& tracks, const ColoresProceso& colores,
+                   const Geometria& geo) {
+    const OpcionesExportacion& op = geo.op;
+    const int x1 = x0 + lienzo.anchoPx();
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        const TrackGantt& track = tracks[t];
+        const int y = geo.yTrack(t);
+        lienzo.texto(10, y - 32, track.nombre, NEGRO, 2, true);
+        if (!track.metricas.empty()) lienzo.texto(10, y - 15, track.metricas, GRIS_TEXTO);
+
+        size_t primera = std::min(track.ranuras, (size_t)std::max(0, (x0 - Geometria::MARGEN_IZQUIERDO) / op.anchoBloque));
+        size_t ultima = std::min(track.ranuras, (size_t)std::max(0, (x1 - Geometria::MARGEN_IZQUIERDO) / op.anchoBloque + 1));
+        for (size_t i = primera; i < ultima; ++i) {
+            const HistorialGantt::Ranura r = track.ranura(i);
+            const int x = geo.xRanura(i);
+            const int w = op.anchoBloque - 2, h = op.altoBloque;
+
+            std::string ciclo = "C" + std::to_string(r.ciclo);
+            lienzo.texto(x + (op.anchoBloque - Lienzo::anchoTexto(ciclo, 1)) / 2, y - 10, ciclo, NEGRO);
+
+            std::string etiqueta = r.contenido;
+            ColorRGB colorTexto = NEGRO;
+            switch (tipoRanura(r.contenido)) {
+            case TipoRanura::IDLE:
+                lienzo.rectangulo(x, y, w, h, {220, 220, 220});
+                lienzo.borde(x, y, w, h, 1, {100, 100, 100});
+                etiqueta = "IDLE";
+                colorTexto = GRIS_TEXTO;
+                break;
+            case TipoRanura::CS:
+                lienzo.trama(x, y, w, h, {60, 60, 60});
+                lienzo.borde(x, y, w, h, 1, {60, 60, 60});
+                break;
+            case TipoRanura::ESPERA:
+                lienzo.rectangulo(x, y, w, h, {255, 200, 200});
+                lienzo.borde(x, y, w, h, 2, {200, 0, 0}, true);
+                break;
+            case TipoRanura::PROCESO:
+                lienzo.rectangulo(x, y, w, h, colorDe(colores, r.contenido));
+                lienzo.borde(x, y, w, h, 2, {0, 150, 0});
+                break;
+            }
+            lienzo.texto(x + (op.anchoBloque - Lienzo::anchoTexto(etiqueta, 1)) / 2, y + (h - 7) / 2, etiqueta,
+                         colorTexto);
+        }
+
+        if (t + 1 < tracks.size()) {
+            lienzo.lineaHorizontal(y + op.altoBloque + Geometria::SEPARACION / 2, {200, 200, 200});
+        }
+    }
+}
+
+uint32_t crc32(const uint8_t* datos, size_t n, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> tabla = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) crc = tabla[(crc ^ datos[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// PNG RGB de 8 bits. Cada fila se filtra con Up si repite la anterior (queda
+// en ceros) o con Sub si no (los bloques planos también quedan en ceros), y
+// se comprime con un único bloque deflate de Huffman fijo cuyas únicas
+// coincidencias son repeticiones del byte anterior (distancia 1): en un
+// Gantt casi todo es color plano, así que eso basta.
+class EscritorPNG {
+public:
+    bool abrir(const std::string& archivo, int ancho, int alto) {
+        out.open(archivo, std::ios::binary);
+        if (!out) return false;
+        out.write("\x89PNG\r\n\x1a\n", 8);
+        uint8_t ihdr[13];
+        escribirBE(ihdr, ancho);
+        escribirBE(ihdr + 4, alto);
+        ihdr[8] = 8;  // Bits por canal
+        ihdr[9] = 2;  // RGB
+        ihdr[10] = ihdr[11] = ihdr[12] = 0;
+        chunk("IHDR", ihdr, sizeof(ihdr));
+
+        idat.push_back(0x78); // zlib, ventana de 32 KiB
+        idat.push_back(0x01);
+        bits(1, 1);           // Último bloque
+        bits(1, 2);           // Huffman fijo
+        return true;
+    }
+
+    void fila(const uint8_t* actual, const uint8_t* anterior, size_t bytes) {
+        if (anterior && std::memcmp(actual, anterior, bytes) == 0) {
+            // Up sobre una fila repetida: el tipo de filtro y `bytes` ceros,
+            // sin recorrerlos uno por uno
+            const uint8_t inicio[2] = {2, 0};
+            comprimir(inicio, 2);
+            adlerB = (uint32_t)((adlerB + (uint64_t)adlerA * (bytes - 1)) % 65521);
+            repetirPrevio(bytes - 1);
+        } else {
+            filtrada.resize(bytes + 1);
+            filtrada[0] = 1;
+            for (size_t i = 0; i < bytes; ++i) filtrada[i + 1] = actual[i] - (i >= 3 ? actual[i - 3] : 0);
+            comprimir(filtrada.data(), filtrada.size());
+        }
+        if (idat.size() >= (1u << 16)) vaciarIDAT();
+    }
+
+    bool cerrar() {
+        simbolo(256);          // Fin de bloque
+        if (nbits > 0) idat.push_back((uint8_t)acumulado);
+        acumulado = 0;
+        nbits = 0;
+        uint8_t adler[4];
+        escribirBE(adler, (adlerB << 16) | adlerA);
+        idat.insert(idat.end(), adler, adler + 4);
+        vaciarIDAT();
+        chunk("IEND", nullptr, 0);
+        out.close();
+        return !out.fail();
+    }
+
+private:
+    static void escribirBE(uint8_t* p, uint32_t v) {
+        p[0] = v >> 24;
+        p[1] = v >> 16;
+        p[2] = v >> 8;
+        p[3] = v;
+    }
+
+    void chunk(const char* tipo, const uint8_t* datos, size_t n) {
+        uint8_t cabecera[8];
+        escribirBE(cabecera, (uint32_t)n);
+        std::memcpy(cabecera + 4, tipo, 4);
+        uint32_t crc = crc32(cabecera + 4, 4);
+        if (n) crc = crc32(datos, n, crc);
+        uint8_t cola[4];
+        escribirBE(cola, crc);
+        out.write((const char*)cabecera, 8);
+        if (n) out.write((const char*)datos, n);
+        out.write((const char*)cola, 4);
+    }
+
+    void vaciarIDAT() {
+        if (idat.empty()) return;
+        chunk("IDAT", idat.data(), idat.size());
+        idat.clear();
+    }
+
+    void bits(uint32_t valor, int n) {
+        acumulado |= valor << nbits;
+        nbits += n;
+        while (nbits >= 8) {
+            idat.push_back((uint8_t)acumulado);
+            acumulado >>= 8;
+            nbits -= 8;
+        }
+    }
+
+    // Los códigos de Huffman van con el bit más significativo primero
+    static uint32_t invertir(uint32_t c, int n) {
+        uint32_t invertido = 0;
+        for (int i = 0; i < n; ++i) invertido |= ((c >> i) & 1) << (n - 1 - i);
+        return invertido;
+    }
+
+    void codigo(uint32_t c, int n) { bits(invertir(c, n), n); }
+
+    struct CodigoFijo {
+        uint16_t bits;
+        uint8_t largo;
+    };
+
+    void simbolo(int v) {
+        static const std::array<CodigoFijo, 288> tabla = [] {
+            std::array<CodigoFijo, 288> t{};
+            for (int s = 0; s < 288; ++s) {
+                if (s < 144) t[s] = {(uint16_t)invertir(0x30 + s, 8), 8};
+                else if (s < 256) t[s] = {(uint16_t)invertir(0x190 + s - 144, 9), 9};
+                else if (s < 280) t[s] = {(uint16_t)invertir(s - 256, 7), 7};
+                else t[s] = {(uint16_t)invertir(0xC0 + s - 280, 8), 8};
+            }
+            return t;
+        }();
+        bits(tabla[v].bits, tabla[v].largo);
+    }
+
+    void repeticion(int largo) {
+        static const int base[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                     31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const int extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                      2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        int k = 28;
+        while (base[k] > largo) --k;
+        simbolo(257 + k);
+        if (extra[k]) bits(largo - base[k], extra[k]);
+        codigo(0, 5);          // Distancia 1
+    }
+
+    // `largo` copias más del último byte emitido
+    void repetirPrevio(size_t largo) {
+        while (largo >= 3) {
+            size_t k = std::min<size_t>(largo, 258);
+            if (largo - k > 0 && largo - k < 3) k = largo - 3;
+            repeticion((int)k);
+            largo -= k;
+        }
+        for (; largo > 0; --largo) simbolo(previo);
+    }
+
+    void comprimir(const uint8_t* datos, size_t n) {
+        // Adler-32 reduciendo cada 5552 bytes, antes de que B desborde
+        for (size_t i = 0; i < n;) {
+            size_t fin = std::min(n, i + 5552);
+            for (; i < fin; ++i) {
+                adlerA += datos[i];
+                adlerB += adlerA;
+            }
+            adlerA %= 65521;
+            adlerB %= 65521;
+        }
+        for (size_t i = 0; i < n;) {
+            size_t largo = 0;
+            if (hayPrevio) {
+                while (i + largo < n && largo < 258 && datos[i + largo] == previo) ++largo;
+            }
+            if (largo >= 3) {
+                repeticion((int)largo);
+                i += largo;
+                continue;
+            }
+            simbolo(datos[i]);
+            previo = datos[i];
+            hayPrevio = true;
+            ++i;
+        }
+    }
+
+    std::ofstream out;
+    std::vector<uint8_t> idat;
+    std::vector<uint8_t> filtrada;
+    uint32_t acumulado = 0;
+    int nbits = 0;
+    uint32_t adlerA = 1, adlerB = 0;
+    uint8_t previo = 0;
+    bool hayPrevio = false;
+};
+
+std::string nombreTesela(const std::string& archivo, int indice) {
+    std::string base = archivo, extension = ".png";
+    size_t punto = archivo.rfind('.');
+    if (punto != std::string::npos && archivo.find('/', punto) == std::string::npos) {
+        base = archivo.substr(0, punto);
+        extension = archivo.substr(punto);
+    }
+    char sufijo[16];
+    std::snprintf(sufijo, sizeof(sufijo), "_%03d", indice);
+    return base + sufijo + extension;
+}
+
+}
+
+bool exportarGanttSVG(const std::string& archivo, const std::vector<TrackGantt>& tracks,
+                      const ColoresProceso& colores, const OpcionesExportacion& opciones) {
+    INSTR_FASE("exportar_svg");
+    std::ofstream out(archivo);
+    if (!out) return false;
+    const Geometria geo = medir(tracks, opciones);
+    const int w = opciones.anchoBloque - 2, h = opciones.altoBloque;
+
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << geo.ancho() << "\" height=\"" << geo.alto()
+        << "\" font-family=\"sans-serif\">\n"
+        << "<defs><pattern id=\"cs\" patternUnits=\"userSpaceOnUse\" width=\"8\" height=\"8\">"
+        << "<path d=\"M0,8 L8,0\" stroke=\"#3c3c3c\"/></pattern></defs>\n"
+        << "<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>\n";
+
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        const TrackGantt& track = tracks[t];
+        const int y = geo.yTrack(t);
+        out << "<g>\n<text x=\"10\" y=\"" << y - 18 << "\" font-size=\"16\" font-weight=\"bold\">"
+            << escaparXML(track.nombre) << "</text>\n";
+        if (!track.metricas.empty()) {
+            out << "<text x=\"10\" y=\"" << y - 4 << "\" font-size=\"12\" fill=\"#646464\">"
+                << escaparXML(track.metricas) << "</text>\n";
+        }
+        for (size_t i = 0; i < track.ranuras; ++i) {
+            const HistorialGantt::Ranura r = track.ranura(i);
+            const int x = geo.xRanura(i);
+            const int centro = x + opciones.anchoBloque / 2;
+            out << "<text x=\"" << centro << "\" y=\"" << y - 1 << "\" font-size=\"10\" text-anchor=\"middle\">C"
+                << r.ciclo << "</text>";
+
+            std::string etiqueta = r.contenido, colorTexto = "#000000";
+            out << "<rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << w << "\" height=\"" << h << "\" ";
+            switch (tipoRanura(r.contenido)) {
+            case TipoRanura::IDLE:
+                out << "fill=\"#dcdcdc\" stroke=\"#646464\"";
+                etiqueta = "IDLE";
+                colorTexto = "#646464";
+                break;
+            case TipoRanura::CS:
+                out << "fill=\"url(#cs)\" stroke=\"#3c3c3c\"";
+                break;
+            case TipoRanura::ESPERA:
+                out << "fill=\"#ffc8c8\" stroke=\"#c80000\" stroke-width=\"2\" stroke-dasharray=\"2,2\"";
+                break;
+            case TipoRanura::PROCESO:
+                out << "fill=\"" << hex(colorDe(colores, r.contenido)) << "\" stroke=\"#009600\" stroke-width=\"2\"";
+                break;
+            }
+            out << "/><text x=\"" << centro << "\" y=\"" << y + h / 2 << "\" font-size=\"11\" text-anchor=\"middle\" "
+                << "dominant-baseline=\"central\" fill=\"" << colorTexto << "\">" << escaparXML(etiqueta) << "</text>\n";
+        }
+        if (t + 1 < tracks.size()) {
+            int ySep = y + opciones.altoBloque + Geometria::SEPARACION / 2;
+            out << "<line x1=\"0\" y1=\"" << ySep << "\" x2=\"" << geo.ancho() << "\" y2=\"" << ySep
+                << "\" stroke=\"#c8c8c8\"/>\n";
+        }
+        out << "</g>\n";
+    }
+    out << "</svg>\n";
+    out.close();
+    return !out.fail();
+}
+
+int exportarGanttPNG(const std::string& archivo, const std::vector<TrackGantt>& tracks,
+                     const ColoresProceso& colores, const OpcionesExportacion& opciones) {
+    INSTR_FASE("exportar_png");
+    const Geometria geo = medir(tracks, opciones);
+    const int anchoTotal = geo.ancho(), alto = geo.alto();
+    const int anchoTesela = std::max(opciones.anchoBloque, opciones.anchoTesela);
+    const int teselas = (anchoTotal + anchoTesela - 1) / anchoTesela;
+
+    for (int k = 0; k < teselas; ++k) {
+        const int x0 = k * anchoTesela;
+        Lienzo lienzo(x0, std::min(anchoTesela, anchoTotal - x0), alto);
+        dibujarTesela(lienzo, x0, tracks, colores, geo);
+
+        EscritorPNG png;
+        if (!png.abrir(teselas == 1 ? archivo : nombreTesela(archivo, k), lienzo.anchoPx(), alto)) return -1;
+        const size_t bytesFila = (size_t)lienzo.anchoPx() * 3;
+        for (int y = 0; y < alto; ++y) {
+            png.fila(lienzo.fila(y), y > 0 ? lienzo.fila(y - 1) : nullptr, bytesFila);
+        }
+        if (!png.cerrar()) return -1;
+    }
+    return teselas;
+}
@@ -0,0 +1,60 @@
+#ifndef EXPORTAR_GANTT_H
+#define EXPORTAR_GANTT_H
+#include "historial_gantt.h"
+#include "scheduler.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Exportación del Gantt multi-track sin wxWidgets. Las ranuras se piden por
+// índice a cada track (un HistorialGantt, que puede estar en disco, o el
+// timeline de un resultado), así que nunca se copia el timeline completo:
+// el SVG se escribe ranura por ranura y el PNG se dibuja en teselas de
+// ancho fijo, una a la vez. La geometría y los colores son los de GanttPanel.
+
+struct ColorRGB {
+    uint8_t r, g, b;
+};
+
+using ColoresProceso = std::map<std::string, ColorRGB>;
+
+// Color del i-ésimo proceso cargado: diez colores fijos y luego una
+// secuencia determinista (la de SchedulingPanel::OnLoadProcesses)
+ColorRGB colorProceso(size_t i);
+ColoresProceso asignarColores(const std::vector<Proceso>& procesos);
+
+// "Avg WT: ... | Avg TAT: ... | CS: ..." bajo el nombre de cada track
+std::string resumenMetricas(const SimulationResult& result);
+
+struct TrackGantt {
+    std::string nombre;
+    std::string metricas;                                // "" = sin línea de métricas
+    size_t ranuras = 0;
+    std::function<HistorialGantt::Ranura(size_t)> ranura;
+};
+
+TrackGantt trackDesdeHistorial(const std::string& nombre, const HistorialGantt& historial,
+                               const std::string& metricas = "");
+TrackGantt trackDesdeTimeline(const std::string& nombre, const std::vector<std::pair<std::string, int>>& timeline,
+                              const std::string& metricas = "");
+
+struct OpcionesExportacion {
+    int anchoBloque = 70;
+    int altoBloque = 50;
+    int altoTrack = 100;
+    int anchoTesela = 4096;       // PNG: ancho en píxeles de cada archivo
+};
+
+// Devuelven false si no se pudo escribir el archivo
+bool exportarGanttSVG(const std::string& archivo, const std::vector<TrackGantt>& tracks,
+                      const ColoresProceso& colores, const OpcionesExportacion& opciones = OpcionesExportacion());
+
+// Un solo PNG si el Gantt cabe en una tesela; si no, base_000.png,
+// base_001.png, ... de izquierda a derecha. Devuelve cuántas teselas se
+// escribieron, o -1 si falló alguna.
+int exportarGanttPNG(const std::string& archivo, const std::vector<TrackGantt>& tracks,
+                     const ColoresProceso& colores, const OpcionesExportacion& opciones = OpcionesExportacion());
+
+#endif
@@ -0,0 +1,237 @@
+// forma_cerrada.cpp
+// Métricas de FIFO, SJF y Priority sin simular ciclo a ciclo. En los no
+// expropiativos basta con el orden de ejecución: si d_k es la ráfaga más el
+// cambio de contexto del k-ésimo proceso y D_k su suma prefija, el instante
+// en que termina es
+//
+//   C_k = D_k + max(0, max_{j<=k}(a_j - D_{j-1}))
+//
+// es decir, una suma prefija y un máximo acumulado sobre arreglos contiguos.
+#include "motor.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Suma prefija inclusiva, in situ
+void sumaPrefija(std::vector<int>& v) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i acarreo = _mm_setzero_si128();
+    for (; i + 4 <= v.size(); i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&v[i]));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, acarreo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&v[i]), x);
+        acarreo = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#endif
+    int acumulado = i ? v[i - 1] : 0;
+    for (; i < v.size(); ++i) {
+        acumulado += v[i];
+        v[i] = acumulado;
+    }
+}
+
+#if defined(__SSE2__)
+// SSE2 no tiene máximo de enteros de 32 bits (pmaxsd es de SSE4.1)
+inline __m128i maximo(__m128i a, __m128i b) {
+    __m128i mayor = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(mayor, a), _mm_andnot_si128(mayor, b));
+}
+#endif
+
+// Máximo acumulado inclusivo, in situ, partiendo de `inicial`
+void maximoPrefijo(std::vector<int>& v, int inicial) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Los carriles que entran por el desplazamiento valen INT_MIN, no cero
+    const __m128i relleno1 = _mm_setr_epi32(INT_MIN, 0, 0, 0);
+    const __m128i relleno2 = _mm_setr_epi32(INT_MIN, INT_MIN, 0, 0);
+    __m128i acarreo = _mm_set1_epi32(inicial);
+    for (; i + 4 <= v.size(); i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&v[i]));
+        x = maximo(x, _mm_or_si128(_mm_slli_si128(x, 4), relleno1));
+        x = maximo(x, _mm_or_si128(_mm_slli_si128(x, 8), relleno2));
+        x = maximo(x, acarreo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&v[i]), x);
+        acarreo = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#endif
+    int acumulado = i ? v[i - 1] : inicial;
+    for (; i < v.size(); ++i) {
+        acumulado = std::max(acumulado, v[i]);
+        v[i] = acumulado;
+    }
+}
+
+// Orden estable de los índices por clave. Con un rango de claves pequeño
+// (prioridades) basta un conteo; si no, se ordenan pares contiguos.
+std::vector<int> ordenEstable(const std::vector<int>& claves) {
+    size_t n = claves.size();
+    std::vector<int> orden(n);
+    if (n == 0) return orden;
+
+    auto [menor, mayor] = std::minmax_element(claves.begin(), claves.end());
+    long long rango = (long long)*mayor - *menor + 1;
+    if (rango <= (long long)std::max<size_t>(n, 1024)) {
+        std::vector<int> inicio(rango + 1, 0);
+        for (int c : claves) inicio[c - *menor + 1]++;
+        std::partial_sum(inicio.begin(), inicio.end(), inicio.begin());
+        for (size_t i = 0; i < n; ++i) orden[inicio[claves[i] - *menor]++] = (int)i;
+        return orden;
+    }
+
+    // El índice desempata, así que std::sort da un orden estable
+    std::vector<std::pair<int, int>> pares(n);
+    for (size_t i = 0; i < n; ++i) pares[i] = {claves[i], (int)i};
+    std::sort(pares.begin(), pares.end());
+    for (size_t i = 0; i < n; ++i) orden[i] = pares[i].second;
+    return orden;
+}
+
+// SJF: cada vez que el CPU se libera gana la menor ráfaga entre los que ya
+// llegaron (a igualdad, el menor índice). Sólo se sigue el reloj para saber
+// quién llegó; los tiempos finales salen del barrido común.
+std::vector<int> ordenSJF(const std::vector<Proceso>& procesos, const std::vector<int>& llegadas,
+                          const std::vector<int>& rafagas, int contextSwitch) {
+    std::vector<int> porLlegada = ordenEstable(llegadas);
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> listos;
+    std::vector<int> orden;
+    orden.reserve(procesos.size());
+
+    long long t = 0;
+    size_t siguiente = 0;
+    int ultimo = -1;
+    while (orden.size() < procesos.size()) {
+        while (siguiente < porLlegada.size() && llegadas[porLlegada[siguiente]] <= t) {
+            int idx = porLlegada[siguiente++];
+            listos.push({rafagas[idx], idx});
+        }
+        if (listos.empty()) {
+            t = llegadas[porLlegada[siguiente]];  // CPU IDLE hasta la próxima llegada
+            continue;
+        }
+        int idx = listos.top().second;
+        listos.pop();
+        bool cambio = ultimo != -1 && procesos[ultimo].pid != procesos[idx].pid;
+        t += (cambio ? contextSwitch : 0) + rafagas[idx];
+        ultimo = idx;
+        orden.push_back(idx);
+    }
+    return orden;
+}
+
+}
+
+std::optional<SimulationResult> formaCerrada(Algoritmo algoritmo, std::vector<Proceso>& procesos,
+                                             const SimulationConfig& config) {
+    if (!config.soloMetricas || config.traza || config.checkpoints) return std::nullopt;
+    if (algoritmo != Algoritmo::FIFO && algoritmo != Algoritmo::SJF && algoritmo != Algoritmo::PRIORITY) {
+        return std::nullopt;
+    }
+
+    if (config.cancelacion && config.cancelacion->cancelado()) return SimulationResult();
+
+    INSTR_FASE("forma_cerrada");
+    size_t n = procesos.size();
+
+    // Una sola pasada secuencial por los Proceso; de aquí en adelante se
+    // trabaja sobre arreglos contiguos hasta escribir los resultados
+    std::vector<int> llegadas(n), rafagas(n), prioridades;
+    std::vector<uint8_t> otroPid;  // FIFO: el pid difiere del proceso anterior (cambio de contexto)
+    if (algoritmo == Algoritmo::FIFO) otroPid.resize(n);
+    if (algoritmo == Algoritmo::PRIORITY) prioridades.resize(n);
+    bool porLlegada = true;
+    for (size_t i = 0; i < n; ++i) {
+        const Proceso& p = procesos[i];
+        if (!p.es.empty() || p.burst_time < 1) return std::nullopt;
+        llegadas[i] = p.arrival_time;
+        rafagas[i] = p.burst_time;
+        porLlegada = porLlegada && (i == 0 || llegadas[i - 1] <= llegadas[i]);
+        if (!otroPid.empty()) otroPid[i] = i > 0 && p.pid != procesos[i - 1].pid;
+        if (!prioridades.empty()) prioridades[i] = p.priority;
+    }
+
+    // orden vacío = identidad
+    std::vector<int> orden;
+    if (algoritmo == Algoritmo::FIFO && !porLlegada) {
+        // FIFO devuelve los procesos reordenados por llegada, igual que el motor
+        std::vector<int> permutacion = ordenEstable(llegadas);
+        std::vector<Proceso> ordenados;
+        ordenados.reserve(n);
+        for (size_t k = 0; k < n; ++k) {
+            ordenados.push_back(std::move(procesos[permutacion[k]]));
+            llegadas[k] = ordenados.back().arrival_time;
+            rafagas[k] = ordenados.back().burst_time;
+            otroPid[k] = k > 0 && ordenados[k].pid != ordenados[k - 1].pid;
+        }
+        procesos = std::move(ordenados);
+    } else if (algoritmo == Algoritmo::SJF) {
+        orden = ordenSJF(procesos, llegadas, rafagas, config.contextSwitch);
+    } else if (algoritmo == Algoritmo::PRIORITY) {
+        // Priority elige entre todos los no terminados sin mirar la llegada
+        orden = ordenEstable(prioridades);
+    }
+
+    SimulationResult result;
+
+    // d_k y llegadas en el orden de ejecución
+    std::vector<int> acumulado(n), llegada(n);
+    for (size_t k = 0; k < n; ++k) {
+        int idx = orden.empty() ? (int)k : orden[k];
+        bool cambio = k > 0 && (orden.empty() ? otroPid[k] : procesos[orden[k - 1]].pid != procesos[idx].pid);
+        int cs = 0;
+        if (cambio) {
+            result.contextSwitches++;
+            cs = config.contextSwitch;
+        }
+        acumulado[k] = cs + rafagas[idx];
+        // Priority no espera llegadas; las negativas equivalen a llegar en 0
+        llegada[k] = algoritmo == Algoritmo::PRIORITY ? 0 : std::max(0, llegadas[idx]);
+    }
+
+    sumaPrefija(acumulado);
+    for (size_t k = n; k-- > 1;) {
+        llegada[k] -= acumulado[k - 1];
+    }
+    maximoPrefijo(llegada, 0);
+
+    // Fin de cada proceso, indexado por proceso para escribir en secuencia
+    std::vector<int>& fin = acumulado;
+    for (size_t k = 0; k < n; ++k) {
+        fin[k] += llegada[k];
+    }
+    if (!orden.empty()) {
+        for (size_t k = 0; k < n; ++k) llegada[orden[k]] = fin[k];
+        fin.swap(llegada);
+    }
+
+    SeleccionPriority tiemposPriority;
+    PoliticaBase tiempos;
+    for (size_t i = 0; i < n; ++i) {
+        Proceso& p = procesos[i];
+        p.completion_time = fin[i];
+        p.start_time = p.completion_time - p.burst_time;
+        p.remaining_time = 0;
+        p.terminado = true;
+        p.en_cola = false;
+        p.fase = 0;
+        p.en_es = false;
+        if (algoritmo == Algoritmo::PRIORITY) {
+            tiemposPriority.calcularTiempos(p);
+        } else {
+            tiempos.calcularTiempos(p);
+        }
+        registrarTerminado(result, p);
+    }
+    calcularMetricas(result);
+    return result;
+}
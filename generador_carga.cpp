@@ -0,0 +1,49 @@
+#include "generador_carga.h"
+#include <algorithm>
+#include <stdexcept>
+
+bool GeneradorCarga::siguiente(Proceso& p) {
+    if (llegada > INT_MAX) return false;
+    p.pid = "P" + std::to_string(++generados);
+    p.burst_time = rafaga(gen);
+    p.arrival_time = (int)llegada;
+    p.priority = prioridad(gen);
+    p.remaining_time = p.burst_time;
+    llegada += entreLlegadas(gen);
+    return true;
+}
+
+std::vector<Proceso> generarProcesos(int n, unsigned semilla) {
+    GeneradorCarga generador(semilla);
+    std::vector<Proceso> procesos(n);
+    for (Proceso& p : procesos) {
+        if (!generador.siguiente(p)) {
+            throw std::overflow_error("generarProcesos: " + std::to_string(n) +
+                                      " procesos llegan despues del ciclo INT_MAX");
+        }
+    }
+    return procesos;
+}
+
+std::vector<Accion> generarAcciones(int n, std::map<std::string, Recurso>& recursos, unsigned semilla) {
+    std::mt19937 gen(semilla);
+    int numRecursos = std::max(1, n / 10);
+    std::uniform_int_distribution<> recurso(0, numRecursos - 1);
+    std::uniform_int_distribution<> capacidad(1, 3);
+    std::uniform_int_distribution<> proceso(0, 999);
+
+    recursos.clear();
+    for (int r = 0; r < numRecursos; ++r) {
+        Recurso rec;
+        rec.nombre = "R" + std::to_string(r);
+        rec.contador = rec.contador_inicial = capacidad(gen);
+        recursos[rec.nombre] = rec;
+    }
+
+    std::vector<Accion> acciones(n);
+    for (int i = 0; i < n; ++i) {
+        acciones[i] = {"P" + std::to_string(proceso(gen)), (i % 3 == 0) ? "WRITE" : "READ",
+                       "R" + std::to_string(recurso(gen)), i / 4};
+    }
+    return acciones;
+}
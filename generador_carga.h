@@ -0,0 +1,36 @@
+#ifndef GENERADOR_CARGA_H
+#define GENERADOR_CARGA_H
+#include "scheduler.h"
+#include <climits>
+#include <random>
+
+// Cargas sintéticas con semilla fija para el benchmark y las herramientas de
+// línea de comandos: la misma semilla produce siempre la misma carga.
+
+// Llegadas de Poisson con ráfagas uniformes 1..20; utilización cercana a 0.95.
+// Las llegadas son int: en promedio una cada 11 ciclos, así que se agotan al
+// pasar el ciclo INT_MAX, unos 195 millones de procesos.
+class GeneradorCarga {
+public:
+    explicit GeneradorCarga(unsigned semilla) : gen(semilla) {}
+
+    // Devuelve false, sin tocar p, cuando la siguiente llegada ya no cabe en
+    // un int; a partir de ahí todas las llamadas devuelven false
+    bool siguiente(Proceso& p);
+
+private:
+    std::mt19937 gen;
+    std::exponential_distribution<> entreLlegadas{1.0 / 11.0};
+    std::uniform_int_distribution<> rafaga{1, 20};
+    std::uniform_int_distribution<> prioridad{1, 5};
+    double llegada = 0;
+    long long generados = 0;
+};
+
+// Lanza std::overflow_error si los n procesos no caben antes del ciclo INT_MAX
+std::vector<Proceso> generarProcesos(int n, unsigned semilla);
+
+// Acciones repartidas sobre n/10 recursos, unas cuatro por ciclo
+std::vector<Accion> generarAcciones(int n, std::map<std::string, Recurso>& recursos, unsigned semilla);
+
+#endif
@@ -0,0 +1,234 @@
+// herramientas.cpp
+// Herramientas de línea de comandos que usan los motores sin la GUI. Se
+// compilan aparte del benchmark (make tools), con el asignador normal:
+//
+//   ./scheduler_tools --gantt gantt.png --gantt-n 100000
+//   ./scheduler_tools --generar 0 | ./scheduler_tools --online - --algoritmo rr
+#include "scheduler.h"
+#include "generador_carga.h"
+#include "exportar_gantt.h"
+#include "calendarizador_online.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+struct Opciones {
+    std::string gantt;             // Exporta el Gantt de todos los algoritmos a este archivo
+    long long ganttProcesos = 1000;
+    std::string online;            // Archivo o FIFO con el flujo de llegadas; "-" es stdin
+    std::string algoritmo = "fifo";
+    long long ventana = 10000;     // Procesos terminados por renglón de resumen
+    long long generar = -1;        // Escribe una carga de N procesos (0: sin fin) en stdout
+    int quantum = 4;
+};
+
+[[noreturn]] void uso(const char* programa) {
+    std::fprintf(stderr, "Uso: %s --gantt archivo.svg|archivo.png [--gantt-n N] [--quantum q]\n"
+                         "       %s --online archivo|- [--algoritmo fifo|sjf|srt|rr|priority] [--ventana N] "
+                         "[--quantum q]\n"
+                         "       %s --generar N\n", programa, programa, programa);
+    std::exit(1);
+}
+
+Opciones leerOpciones(int argc, char** argv) {
+    Opciones op;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hayValor = i + 1 < argc;
+        if (arg == "--gantt" && hayValor) op.gantt = argv[++i];
+        else if (arg == "--gantt-n" && hayValor) op.ganttProcesos = std::atoll(argv[++i]);
+        else if (arg == "--online" && hayValor) op.online = argv[++i];
+        else if (arg == "--algoritmo" && hayValor) op.algoritmo = argv[++i];
+        else if (arg == "--ventana" && hayValor) op.ventana = std::max(1LL, std::atoll(argv[++i]));
+        else if (arg == "--generar" && hayValor) op.generar = std::atoll(argv[++i]);
+        else if (arg == "--quantum" && hayValor) op.quantum = std::atoi(argv[++i]);
+        else uso(argv[0]);
+    }
+    if (op.gantt.empty() && op.online.empty() && op.generar < 0) uso(argv[0]);
+    return op;
+}
+
+double rssMaximoMiB() {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss / 1024.0;
+}
+
+// Corre todos los algoritmos sobre una carga generada, guardando cada uno en
+// un HistorialGantt, y exporta los tracks sin abrir ninguna ventana
+int exportarGantt(const Opciones& op) {
+    std::vector<Proceso> carga = generarProcesos((int)op.ganttProcesos, 42);
+    SimulationConfig config;
+    config.guardarTimeline = false; // El historial es la única copia
+
+    const char* nombres[] = {"FIFO", "SJF", "SRT", "Round Robin", "Priority", "Lottery", "Stride"};
+    const int numAlgoritmos = sizeof(nombres) / sizeof(nombres[0]);
+    std::vector<HistorialGantt> historiales(numAlgoritmos);
+    std::vector<SimulationResult> resultados;
+    for (int a = 0; a < numAlgoritmos; ++a) {
+        std::vector<Proceso> procesos = carga;
+        HistorialGantt& historial = historiales[a];
+        UpdateCallback registrar = [&historial](const std::string& contenido, int ciclo) {
+            historial.agregar(contenido, ciclo);
+        };
+        switch (a) {
+            case 0: resultados.push_back(fifo(procesos, registrar, config)); break;
+            case 1: resultados.push_back(sjf(procesos, registrar, config)); break;
+            case 2: resultados.push_back(srt(procesos, registrar, config)); break;
+            case 3: resultados.push_back(roundRobin(procesos, op.quantum, registrar, config)); break;
+            case 4: resultados.push_back(priority(procesos, registrar, config)); break;
+            case 5: resultados.push_back(lottery(procesos, op.quantum, registrar, config)); break;
+            default: resultados.push_back(stride(procesos, op.quantum, registrar, config)); break;
+        }
+    }
+
+    std::vector<TrackGantt> tracks;
+    for (int a = 0; a < numAlgoritmos; ++a) {
+        tracks.push_back(trackDesdeHistorial(nombres[a], historiales[a], resumenMetricas(resultados[a])));
+    }
+    ColoresProceso colores = asignarColores(carga);
+
+    auto inicio = std::chrono::steady_clock::now();
+    bool svg = op.gantt.size() >= 4 && op.gantt.compare(op.gantt.size() - 4, 4, ".svg") == 0;
+    int teselas = svg ? (exportarGanttSVG(op.gantt, tracks, colores) ? 1 : -1)
+                      : exportarGanttPNG(op.gantt, tracks, colores);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    if (teselas < 0) {
+        std::fprintf(stderr, "No se pudo escribir %s\n", op.gantt.c_str());
+        return 1;
+    }
+
+    std::printf("Gantt de %lld procesos (%zu ranuras en el track mas largo) en %d archivo(s), %.2f s, RSS %.1f MiB\n",
+                op.ganttProcesos, std::max_element(historiales.begin(), historiales.end(),
+                    [](const HistorialGantt& a, const HistorialGantt& b) { return a.size() < b.size(); })->size(),
+                teselas, segundos, rssMaximoMiB());
+    return 0;
+}
+
+// Escribe la carga generada en el formato de procesos.txt, para alimentar
+// --online por un pipe. Con n = 0 no termina.
+int generarFlujo(const Opciones& op) {
+    GeneradorCarga generador(42);
+    Proceso p;
+    for (long long i = 0; op.generar == 0 || i < op.generar; ++i) {
+        if (!generador.siguiente(p)) {
+            std::fprintf(stderr, "Las llegadas pasaron del ciclo INT_MAX tras %lld procesos\n", i);
+            return 1;
+        }
+        if (std::printf("%s,%d,%d,%d\n", p.pid.c_str(), p.burst_time, p.arrival_time, p.priority) < 0) {
+            break; // Se cerró el otro extremo del pipe
+        }
+    }
+    return 0;
+}
+
+bool leerAlgoritmo(const std::string& nombre, Algoritmo& algoritmo) {
+    static const std::pair<const char*, Algoritmo> nombres[] = {
+        {"fifo", Algoritmo::FIFO}, {"sjf", Algoritmo::SJF}, {"srt", Algoritmo::SRT},
+        {"rr", Algoritmo::ROUND_ROBIN}, {"priority", Algoritmo::PRIORITY},
+        {"lottery", Algoritmo::LOTTERY}, {"stride", Algoritmo::STRIDE},
+    };
+    for (const auto& [texto, valor] : nombres) {
+        if (nombre == texto) {
+            algoritmo = valor;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Calendariza un flujo de llegadas sin cargarlo completo. Cada proceso
+// terminado se escribe en stdout (TSV) y cada op.ventana procesos se resume la
+// ventana en stderr, para ver derivar las métricas mientras corre.
+int correrOnline(const Opciones& op) {
+    Algoritmo algoritmo;
+    if (!leerAlgoritmo(op.algoritmo, algoritmo)) {
+        std::fprintf(stderr, "Algoritmo desconocido: %s\n", op.algoritmo.c_str());
+        return 1;
+    }
+    std::ifstream archivo;
+    std::istream* entrada = &std::cin;
+    if (op.online != "-") {
+        archivo.open(op.online);
+        if (!archivo) {
+            std::fprintf(stderr, "No se pudo abrir %s\n", op.online.c_str());
+            return 1;
+        }
+        entrada = &archivo;
+    }
+    std::ios::sync_with_stdio(false);
+
+    LectorProcesos lector(*entrada);
+    std::unique_ptr<CalendarizadorOnline> motor =
+        crearCalendarizadorOnline(algoritmo, std::ref(lector), SimulationConfig(), op.quantum);
+    if (!motor) {
+        std::fprintf(stderr, "%s no tiene modo en linea\n", op.algoritmo.c_str());
+        return 1;
+    }
+
+    SketchCuantiles espera, retorno, respuesta;
+    auto resumirVentana = [&]() {
+        std::fprintf(stderr, "ciclo %d | vivos %zu | terminados %lld | WT prom %.2f p99 %.0f | "
+                             "TAT prom %.2f p99 %.0f | RT prom %.2f p99 %.0f | RSS max %.1f MiB\n",
+                     motor->cicloActual(), motor->vivos(), motor->terminados(), espera.promedio(),
+                     espera.cuantil(0.99), retorno.promedio(), retorno.cuantil(0.99), respuesta.promedio(),
+                     respuesta.cuantil(0.99), rssMaximoMiB());
+        espera = retorno = respuesta = SketchCuantiles();
+    };
+
+    std::printf("pid\tllegada\tinicio\tfin\tespera\tretorno\trespuesta\n");
+    motor->setAlTerminar([&](const Proceso& p) {
+        std::printf("%s\t%d\t%d\t%d\t%d\t%d\t%d\n", p.pid.c_str(), p.arrival_time, p.start_time,
+                    p.completion_time, p.waiting_time, p.turnaround_time, p.response_time);
+        espera.agregar(p.waiting_time);
+        retorno.agregar(p.turnaround_time);
+        respuesta.agregar(p.response_time);
+        if (espera.cantidad() >= op.ventana) {
+            resumirVentana();
+        }
+    });
+
+    auto inicio = std::chrono::steady_clock::now();
+    motor->runToEnd();
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    if (espera.cantidad() > 0) {
+        resumirVentana();
+    }
+
+    const SimulationResult& total = motor->resultado();
+    std::fflush(stdout);
+    std::fprintf(stderr, "Total: %lld procesos en %d ciclos | WT prom %.2f p99 %.0f | TAT prom %.2f | "
+                         "RT prom %.2f | CS %d | CPU %.1f%% | %.0f ns/ciclo\n",
+                 motor->terminados(), motor->cicloActual(), total.avgWaitingTime, total.waiting.cuantil(0.99),
+                 total.avgTurnaroundTime, total.avgResponseTime, total.contextSwitches,
+                 total.cpuUtilization * 100, motor->cicloActual() ? segundos * 1e9 / motor->cicloActual() : 0.0);
+    if (lector.lineasIgnoradas() > 0 || motor->llegadasTardias() > 0) {
+        std::fprintf(stderr, "Lineas ignoradas: %lld | llegadas fuera de orden: %lld\n",
+                     lector.lineasIgnoradas(), motor->llegadasTardias());
+    }
+    if (motor->limiteAlcanzado()) {
+        std::fprintf(stderr, "El reloj llego al ciclo INT_MAX; se detuvo con %zu procesos vivos\n",
+                     motor->vivos());
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Opciones op = leerOpciones(argc, argv);
+    if (op.generar >= 0) {
+        return generarFlujo(op);
+    }
+    if (!op.online.empty()) {
+        return correrOnline(op);
+    }
+    return exportarGantt(op);
+}
@@ -0,0 +1,88 @@
+#include "historial_gantt.h"
+#include <algorithm>
+
+HistorialGantt::HistorialGantt(size_t maxSegmentosEnMemoria)
+    : maxSegmentos(maxSegmentosEnMemoria < 2 ? 2 : maxSegmentosEnMemoria) {}
+
+void HistorialGantt::agregar(const std::string& contenido, int ciclo) {
+    auto [it, nueva] = idsEtiqueta.emplace(contenido, (uint32_t)etiquetas.size());
+    if (nueva) {
+        etiquetas.push_back(contenido);
+    }
+
+    size_t indice = total / RANURAS_POR_SEGMENTO;
+    Segmento& segmento = residentes[indice];
+    if (segmento.registros.empty()) {
+        segmento.registros.reserve(RANURAS_POR_SEGMENTO);
+    }
+    segmento.registros.push_back({it->second, ciclo});
+    segmento.ultimoUso = ++reloj;
+    total++;
+
+    // Segmento lleno: se escribe una sola vez y desde ahí puede desalojarse
+    if (segmento.registros.size() == RANURAS_POR_SEGMENTO) {
+        if (!archivo) {
+            archivo.reset(std::tmpfile());
+        }
+        if (archivo && segmentosEscritos == indice &&
+            std::fseek(archivo.get(), (long)(indice * RANURAS_POR_SEGMENTO * sizeof(Registro)), SEEK_SET) == 0 &&
+            std::fwrite(segmento.registros.data(), sizeof(Registro), RANURAS_POR_SEGMENTO, archivo.get()) ==
+                RANURAS_POR_SEGMENTO) {
+            segmentosEscritos++;
+        }
+        desalojar();
+    }
+}
+
+HistorialGantt::Ranura HistorialGantt::en(size_t i) const {
+    const Registro& r = cargar(i / RANURAS_POR_SEGMENTO).registros[i % RANURAS_POR_SEGMENTO];
+    return {etiquetas[r.etiqueta], r.ciclo};
+}
+
+const HistorialGantt::Segmento& HistorialGantt::cargar(size_t indice) const {
+    auto it = residentes.find(indice);
+    if (it == residentes.end()) {
+        Segmento segmento;
+        segmento.ultimoUso = ++reloj;
+        segmento.registros.resize(RANURAS_POR_SEGMENTO);
+        size_t leidos = 0;
+        if (std::fseek(archivo.get(), (long)(indice * RANURAS_POR_SEGMENTO * sizeof(Registro)), SEEK_SET) == 0) {
+            leidos = std::fread(segmento.registros.data(), sizeof(Registro), RANURAS_POR_SEGMENTO, archivo.get());
+        }
+        // Lectura corta: lo que falte queda en ceros (primera etiqueta, ciclo 0)
+        // en vez de basura, para que en() nunca salga de etiquetas
+        std::fill(segmento.registros.begin() + leidos, segmento.registros.end(), Registro{0, 0});
+        it = residentes.emplace(indice, std::move(segmento)).first;
+        desalojar(indice);
+    }
+    it->second.ultimoUso = ++reloj;
+    return it->second;
+}
+
+// Descarta los segmentos ya escritos usados hace más tiempo hasta volver al
+// límite. conservar es el segmento que cargar() está por devolver.
+void HistorialGantt::desalojar(size_t conservar) const {
+    while (residentes.size() > maxSegmentos) {
+        auto victima = residentes.end();
+        for (auto it = residentes.begin(); it != residentes.end(); ++it) {
+            if (it->first < segmentosEscritos && it->first != conservar &&
+                (victima == residentes.end() || it->second.ultimoUso < victima->second.ultimoUso)) {
+                victima = it;
+            }
+        }
+        if (victima == residentes.end()) {
+            return; // Sin archivo temporal: todo queda en memoria
+        }
+        residentes.erase(victima);
+    }
+}
+
+void HistorialGantt::clear() {
+    total = 0;
+    etiquetas.clear();
+    idsEtiqueta.clear();
+    residentes.clear();
+    reloj = 0;
+    archivo.reset();
+    segmentosEscritos = 0;
+}
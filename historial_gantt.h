@@ -0,0 +1,63 @@
+#ifndef HISTORIAL_GANTT_H
+#define HISTORIAL_GANTT_H
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Historial de ranuras de un track del Gantt con memoria acotada. Las ranuras
+// se guardan como registros fijos (id de etiqueta + ciclo) en segmentos; cada
+// segmento lleno se escribe una vez a un archivo temporal y solo se mantienen
+// en memoria los más usados, así que al desplazarse hacia atrás los segmentos
+// se vuelven a leer del disco sin que el panel lo note.
+class HistorialGantt {
+public:
+    static constexpr size_t RANURAS_POR_SEGMENTO = 4096;
+
+    explicit HistorialGantt(size_t maxSegmentosEnMemoria = 64);
+
+    // La referencia a contenido es válida hasta el siguiente agregar()
+    struct Ranura {
+        const std::string& contenido;
+        int ciclo;
+    };
+
+    void agregar(const std::string& contenido, int ciclo);
+    Ranura en(size_t i) const;
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+    void clear();
+
+    size_t segmentosEnMemoria() const { return residentes.size(); }
+
+private:
+    struct Registro {
+        uint32_t etiqueta;
+        int32_t ciclo;
+    };
+    struct Segmento {
+        std::vector<Registro> registros;
+        uint64_t ultimoUso = 0;
+    };
+    struct CerrarArchivo {
+        void operator()(std::FILE* f) const { std::fclose(f); }
+    };
+
+    const Segmento& cargar(size_t indice) const;
+    void desalojar(size_t conservar = SIZE_MAX) const;
+
+    size_t maxSegmentos;
+    size_t total = 0;
+    std::vector<std::string> etiquetas;
+    std::unordered_map<std::string, uint32_t> idsEtiqueta;
+
+    // Caché de segmentos; el último (el que se está llenando) nunca se desaloja
+    mutable std::unordered_map<size_t, Segmento> residentes;
+    mutable uint64_t reloj = 0;
+    std::unique_ptr<std::FILE, CerrarArchivo> archivo;
+    size_t segmentosEscritos = 0;
+};
+
+#endif
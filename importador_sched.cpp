@@ -0,0 +1,325 @@
+#include "importador_sched.h"
+#include "instrumentacion.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+// Estado de una tarea mientras se recorre la traza. Los tiempos van en
+// microsegundos desde el arranque del equipo, tal como aparecen en la traza.
+struct Tarea {
+    std::string comm;
+    int prio = 120;
+    long long llegada = -1;        // Inicio de la activación abierta; -1 = dormida
+    long long enCpuDesde = -1;     // -1 = fuera de CPU
+    long long acumulado = 0;       // Tiempo en CPU de la activación abierta
+    long long primeraLlegada = -1; // Sólo para Granularidad::TAREA
+    long long total = 0;
+    int activaciones = 0;
+};
+
+// Datos de una tarea tal como los nombra un evento
+struct Referencia {
+    std::string_view comm;
+    int pid = -1;
+    int prio = 120;
+};
+
+std::string_view recortar(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+bool leerEntero(std::string_view s, int& valor) {
+    s = recortar(s);
+    auto [fin, error] = std::from_chars(s.data(), s.data() + s.size(), valor);
+    return error == std::errc() && fin != s.data();
+}
+
+// "12345.678901" -> microsegundos. Acepta fracciones de 6 (us) o 9 (ns) dígitos.
+bool leerMarcaTiempo(std::string_view s, long long& us) {
+    size_t punto = s.find('.');
+    if (punto == std::string_view::npos) return false;
+    long long segundos = 0;
+    auto [fin, error] = std::from_chars(s.data(), s.data() + punto, segundos);
+    if (error != std::errc() || fin != s.data() + punto) return false;
+    long long fraccion = 0;
+    int digitos = 0;
+    for (size_t i = punto + 1; i < s.size() && digitos < 6; i++, digitos++) {
+        if (s[i] < '0' || s[i] > '9') return false;
+        fraccion = fraccion * 10 + (s[i] - '0');
+    }
+    for (; digitos < 6; digitos++) fraccion *= 10;
+    us = segundos * 1000000 + fraccion;
+    return true;
+}
+
+// Valor de "clave=" hasta el siguiente espacio, o hasta `hasta` si se da
+// (comm puede contener espacios: "prev_comm=Web Content prev_pid=...")
+std::string_view valorDe(std::string_view s, std::string_view clave, std::string_view hasta = {}) {
+    size_t i = s.find(clave);
+    if (i == std::string_view::npos) return {};
+    i += clave.size();
+    size_t j = hasta.empty() ? s.find(' ', i) : s.find(hasta, i);
+    return s.substr(i, j == std::string_view::npos ? std::string_view::npos : j - i);
+}
+
+// Formato clave=valor de ftrace y de perf reciente:
+//   prev_comm=bash prev_pid=12 prev_prio=120 prev_state=S
+bool leerReferenciaClaves(std::string_view s, std::string_view prefijo, Referencia& ref) {
+    std::string claveComm = std::string(prefijo) + "comm=";
+    std::string clavePid = " " + std::string(prefijo) + "pid=";
+    std::string clavePrio = std::string(prefijo) + "prio=";
+    ref.comm = valorDe(s, claveComm, clavePid);
+    return leerEntero(valorDe(s, clavePid.substr(1)), ref.pid) &&
+           leerEntero(valorDe(s, clavePrio), ref.prio);
+}
+
+// Formato compacto de perf: "kworker/1:1:45 [120]". El pid va tras el último
+// ':' antes del corchete; el comm puede contener ':' y espacios.
+bool leerReferenciaCompacta(std::string_view s, Referencia& ref, std::string_view* resto) {
+    size_t corchete = s.find(" [");
+    if (corchete == std::string_view::npos) return false;
+    std::string_view nombre = recortar(s.substr(0, corchete));
+    size_t dosPuntos = nombre.rfind(':');
+    if (dosPuntos == std::string_view::npos) return false;
+    size_t cierre = s.find(']', corchete);
+    if (cierre == std::string_view::npos) return false;
+    ref.comm = nombre.substr(0, dosPuntos);
+    if (resto) *resto = s.substr(cierre + 1);
+    return leerEntero(nombre.substr(dosPuntos + 1), ref.pid) &&
+           leerEntero(s.substr(corchete + 2, cierre - corchete - 2), ref.prio);
+}
+
+// R y R+ = expropiada, sigue lista. Cualquier otro estado la saca de la CPU.
+bool sigueLista(std::string_view estado) {
+    estado = recortar(estado);
+    return estado == "R" || estado == "R+";
+}
+
+bool terminada(std::string_view estado) {
+    estado = recortar(estado);
+    return !estado.empty() && (estado[0] == 'X' || estado[0] == 'Z');
+}
+
+class Importador {
+private:
+    const OpcionesImportacion& opciones;
+    const ProcesoImportado& emitir;
+    EstadisticasImportacion& estadisticas;
+    std::unordered_map<int, Tarea> tareas;
+    long long inicio = -1;
+    long long ultimo = 0;
+
+    int aCiclos(long long us, bool redondearArriba) const {
+        double ciclos = us / opciones.usPorCiclo;
+        return (int)std::min<double>(INT_MAX, redondearArriba ? std::ceil(ciclos) : std::floor(ciclos));
+    }
+
+    Tarea& tarea(const Referencia& ref) {
+        Tarea& t = tareas[ref.pid];
+        if (t.comm.size() != ref.comm.size() || t.comm != ref.comm) t.comm.assign(ref.comm);
+        t.prio = ref.prio;
+        return t;
+    }
+
+    void emitirProceso(int pid, const Tarea& t, long long llegada, long long rafaga, int numero) {
+        if (rafaga <= 0) {
+            estadisticas.descartados++;
+            return;
+        }
+        if (opciones.limite && (size_t)estadisticas.procesos >= opciones.limite) return;
+        Proceso p;
+        p.pid = t.comm + "-" + std::to_string(pid);
+        if (numero > 0) p.pid += "." + std::to_string(numero);
+        p.arrival_time = aCiclos(llegada - inicio, false);
+        p.burst_time = std::max(1, aCiclos(rafaga, true));
+        p.priority = t.prio - 100;
+        p.remaining_time = p.burst_time;
+        estadisticas.procesos++;
+        emitir(std::move(p));
+    }
+
+    // Cierra la activación abierta de la tarea (se bloqueó o terminó)
+    void cerrarActivacion(int pid, Tarea& t) {
+        if (t.llegada < 0) return;
+        if (opciones.granularidad == OpcionesImportacion::Granularidad::ACTIVACION) {
+            emitirProceso(pid, t, t.llegada, t.acumulado, ++t.activaciones);
+        } else {
+            if (t.primeraLlegada < 0) t.primeraLlegada = t.llegada;
+            t.total += t.acumulado;
+        }
+        t.llegada = -1;
+        t.acumulado = 0;
+    }
+
+    void finalizarTarea(int pid, Tarea& t) {
+        if (opciones.granularidad == OpcionesImportacion::Granularidad::TAREA && t.primeraLlegada >= 0) {
+            emitirProceso(pid, t, t.primeraLlegada, t.total, 0);
+        }
+    }
+
+public:
+    Importador(const OpcionesImportacion& opciones, const ProcesoImportado& emitir,
+               EstadisticasImportacion& estadisticas)
+        : opciones(opciones), emitir(emitir), estadisticas(estadisticas) {}
+
+    bool lleno() const {
+        return opciones.limite && (size_t)estadisticas.procesos >= opciones.limite;
+    }
+
+    void despertar(const Referencia& ref, long long ahora) {
+        if (ref.pid <= 0) return;
+        Tarea& t = tarea(ref);
+        if (t.llegada < 0) t.llegada = ahora;
+    }
+
+    void cambio(const Referencia& prev, std::string_view estadoPrev, const Referencia& next, long long ahora) {
+        if (prev.pid > 0) {
+            Tarea& t = tarea(prev);
+            // Ya estaba en CPU cuando empezó la traza: se cuenta desde el primer evento
+            if (t.llegada < 0) t.llegada = inicio;
+            t.acumulado += ahora - (t.enCpuDesde >= 0 ? t.enCpuDesde : std::max(t.llegada, inicio));
+            t.enCpuDesde = -1;
+            if (!sigueLista(estadoPrev)) {
+                cerrarActivacion(prev.pid, t);
+                if (terminada(estadoPrev)) {
+                    finalizarTarea(prev.pid, t);
+                    tareas.erase(prev.pid);
+                }
+            }
+        }
+        if (next.pid > 0) {
+            Tarea& t = tarea(next);
+            if (t.llegada < 0) t.llegada = ahora;  // Lista sin despertar observado
+            t.enCpuDesde = ahora;
+        }
+    }
+
+    void salida(int pid) {
+        auto it = tareas.find(pid);
+        if (it == tareas.end()) return;
+        cerrarActivacion(pid, it->second);
+        finalizarTarea(pid, it->second);
+        tareas.erase(it);
+    }
+
+    // Una línea de la traza; devuelve false si era un evento que no se entendió
+    bool procesar(std::string_view linea) {
+        std::string_view evento;
+        size_t pos = std::string_view::npos;
+        for (std::string_view nombre : {"sched_switch:", "sched_wakeup:", "sched_wakeup_new:",
+                                        "sched_waking:", "sched_process_exit:"}) {
+            pos = linea.find(nombre);
+            if (pos != std::string_view::npos) {
+                evento = nombre;
+                break;
+            }
+        }
+        if (evento.empty()) return true;
+
+        // La marca de tiempo es el token terminado en ':' justo antes del evento
+        // (perf antepone "sched:" al nombre)
+        size_t antes = pos;
+        if (antes >= 6 && linea.substr(antes - 6, 6) == "sched:") antes -= 6;
+        std::string_view cabeza = recortar(linea.substr(0, antes));
+        if (cabeza.empty() || cabeza.back() != ':') return false;
+        cabeza.remove_suffix(1);
+        size_t espacio = cabeza.find_last_of(" \t");
+        long long ahora;
+        if (!leerMarcaTiempo(espacio == std::string_view::npos ? cabeza : cabeza.substr(espacio + 1), ahora)) {
+            return false;
+        }
+        if (inicio < 0) inicio = ahora;
+        ultimo = std::max(ultimo, ahora);
+
+        std::string_view cuerpo = linea.substr(pos + evento.size());
+        estadisticas.eventos++;
+
+        if (evento == "sched_switch:") {
+            size_t flecha = cuerpo.find(" ==> ");
+            if (flecha == std::string_view::npos) return false;
+            std::string_view izquierda = cuerpo.substr(0, flecha);
+            std::string_view derecha = cuerpo.substr(flecha + 5);
+            Referencia prev, next;
+            std::string_view estado;
+            if (izquierda.find("prev_pid=") != std::string_view::npos) {
+                if (!leerReferenciaClaves(izquierda, "prev_", prev) ||
+                    !leerReferenciaClaves(derecha, "next_", next)) return false;
+                estado = valorDe(izquierda, "prev_state=");
+            } else {
+                if (!leerReferenciaCompacta(izquierda, prev, &estado) ||
+                    !leerReferenciaCompacta(derecha, next, nullptr)) return false;
+            }
+            cambio(prev, estado, next, ahora);
+        } else {
+            Referencia ref;
+            bool ok = cuerpo.find("pid=") != std::string_view::npos
+                ? leerReferenciaClaves(cuerpo, "", ref)
+                : leerReferenciaCompacta(cuerpo, ref, nullptr);
+            if (!ok) return false;
+            if (evento == "sched_process_exit:") {
+                salida(ref.pid);
+            } else {
+                despertar(ref, ahora);
+            }
+        }
+        return true;
+    }
+
+    // Cierra lo que sigue abierto en el último instante de la traza
+    void terminar() {
+        for (auto& [pid, t] : tareas) {
+            if (t.enCpuDesde >= 0) {
+                t.acumulado += ultimo - t.enCpuDesde;
+                t.enCpuDesde = -1;
+            }
+            cerrarActivacion(pid, t);
+            finalizarTarea(pid, t);
+        }
+        tareas.clear();
+    }
+};
+
+}
+
+EstadisticasImportacion importarTrazaSched(std::istream& entrada, const OpcionesImportacion& opciones,
+                                           const ProcesoImportado& emitir) {
+    INSTR_FASE("importar_traza_sched");
+    EstadisticasImportacion estadisticas;
+    Importador importador(opciones, emitir, estadisticas);
+    std::string linea;
+
+    while (!importador.lleno() && std::getline(entrada, linea)) {
+        estadisticas.lineas++;
+        if (!importador.procesar(linea)) {
+            estadisticas.ignoradas++;
+        }
+    }
+    importador.terminar();
+    return estadisticas;
+}
+
+std::vector<Proceso> leerTrazaSched(const std::string& filename, const OpcionesImportacion& opciones,
+                                    EstadisticasImportacion* estadisticas) {
+    // Búfer grande: las capturas reales pesan varios GB
+    std::vector<char> bufer(1 << 20);
+    std::ifstream archivo;
+    archivo.rdbuf()->pubsetbuf(bufer.data(), bufer.size());
+    archivo.open(filename);
+
+    std::vector<Proceso> procesos;
+    EstadisticasImportacion e = importarTrazaSched(archivo, opciones,
+        [&procesos](Proceso&& p) { procesos.push_back(std::move(p)); });
+
+    std::stable_sort(procesos.begin(), procesos.end(), [](const Proceso& a, const Proceso& b) {
+        return a.arrival_time < b.arrival_time;
+    });
+    if (estadisticas) *estadisticas = e;
+    return procesos;
+}
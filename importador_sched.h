@@ -0,0 +1,49 @@
+#ifndef IMPORTADOR_SCHED_H
+#define IMPORTADOR_SCHED_H
+#include "scheduler.h"
+#include <istream>
+
+// Importa trazas reales del planificador de Linux como cargas de trabajo.
+// Acepta la salida de texto de `perf sched script` y de ftrace
+// (/sys/kernel/tracing/trace con los eventos sched_switch y sched_wakeup).
+//
+// Cada proceso importado es una activación: desde que la tarea despierta
+// hasta que se bloquea o termina. La ráfaga es el tiempo que estuvo en CPU
+// durante esa activación. La prioridad sale del prio del kernel:
+// priority = prio - 100, es decir nice + 20 para tareas normales (0..39),
+// mientras que las de tiempo real quedan negativas y siempre ganan.
+//
+// La traza se lee línea por línea; la memoria depende del número de tareas
+// vivas, no del tamaño del archivo.
+struct OpcionesImportacion {
+    enum class Granularidad {
+        ACTIVACION,   // Un Proceso por activación (despertar -> bloqueo)
+        TAREA         // Un Proceso por tarea: suma de todas sus activaciones
+    };
+
+    double usPorCiclo = 1000.0;                 // Microsegundos de traza por ciclo simulado
+    Granularidad granularidad = Granularidad::ACTIVACION;
+    size_t limite = 0;                          // Máximo de procesos a emitir; 0 = sin límite
+};
+
+struct EstadisticasImportacion {
+    long long lineas = 0;
+    long long eventos = 0;          // sched_switch/sched_wakeup reconocidos
+    long long ignoradas = 0;        // Líneas de eventos que no se pudieron interpretar
+    long long procesos = 0;         // Emitidos
+    long long descartados = 0;      // Activaciones que nunca llegaron a la CPU
+};
+
+using ProcesoImportado = std::function<void(Proceso&&)>;
+
+// Emite cada proceso en cuanto su activación termina (orden de finalización,
+// no de llegada). Las activaciones abiertas al final de la traza se cierran
+// en el último instante observado.
+EstadisticasImportacion importarTrazaSched(std::istream& entrada, const OpcionesImportacion& opciones,
+                                           const ProcesoImportado& emitir);
+
+// Conveniencia para la GUI: todos los procesos, ordenados por llegada
+std::vector<Proceso> leerTrazaSched(const std::string& filename, const OpcionesImportacion& opciones = {},
+                                    EstadisticasImportacion* estadisticas = nullptr);
+
+#endif
@@ -0,0 +1,135 @@
+#include "instrumentacion.h"
+
+#ifdef SCHED_INSTRUMENTACION
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace instr {
+
+namespace {
+
+const char* nombresContadores[NUM_CONTADORES] = {
+    "iteraciones_seleccion",
+    "push_cola",
+    "pop_cola",
+    "llamadas_callback",
+    "adiciones_timeline",
+    "ns_seleccion",
+    "ns_callback"
+};
+
+struct Evento {
+    const char* nombre;
+    uint64_t inicio;
+    uint64_t duracion;
+    size_t hilo;
+    uint64_t contadores[NUM_CONTADORES];
+};
+
+// Limite de eventos guardados para no crecer sin control en corridas largas
+constexpr size_t MAX_EVENTOS = 1000000;
+
+std::atomic<uint64_t> contadores[NUM_CONTADORES];
+std::mutex mutexEventos;
+std::vector<Evento> eventos;
+uint64_t eventosDescartados = 0;
+const auto origen = std::chrono::steady_clock::now();
+
+uint64_t ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origen).count();
+}
+
+// Microsegundos en punto fijo con los nanosegundos completos: con la
+// precisión por defecto del flujo, pasado un segundo saldría 4.67569e+06
+// y las fases vecinas se encimarían en el visor
+struct Us {
+    uint64_t ns;
+};
+
+std::ostream& operator<<(std::ostream& out, Us us) {
+    char fraccion[4];
+    std::snprintf(fraccion, sizeof(fraccion), "%03u", (unsigned)(us.ns % 1000));
+    return out << us.ns / 1000 << '.' << fraccion;
+}
+
+}
+
+void contar(Contador c, uint64_t n) {
+    contadores[c].fetch_add(n, std::memory_order_relaxed);
+}
+
+uint64_t valor(Contador c) {
+    return contadores[c].load(std::memory_order_relaxed);
+}
+
+void reiniciar() {
+    for (auto& c : contadores) c.store(0);
+    std::lock_guard<std::mutex> lock(mutexEventos);
+    eventos.clear();
+    eventosDescartados = 0;
+}
+
+Fase::Fase(const char* nombre) : nombre(nombre), inicio(ahoraNs()) {}
+
+Fase::~Fase() {
+    Evento e;
+    e.nombre = nombre;
+    e.inicio = inicio;
+    e.duracion = ahoraNs() - inicio;
+    e.hilo = std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000;
+    for (int i = 0; i < NUM_CONTADORES; ++i) e.contadores[i] = valor((Contador)i);
+
+    std::lock_guard<std::mutex> lock(mutexEventos);
+    if (eventos.size() < MAX_EVENTOS) {
+        eventos.push_back(e);
+    } else {
+        eventosDescartados++;
+    }
+}
+
+Acumulador::Acumulador(Contador c) : contador(c), inicio(ahoraNs()) {}
+
+Acumulador::~Acumulador() {
+    contar(contador, ahoraNs() - inicio);
+}
+
+bool exportarTrazaChrome(const std::string& archivo) {
+    std::ofstream out(archivo);
+    if (!out) return false;
+
+    std::lock_guard<std::mutex> lock(mutexEventos);
+    out << "{\"traceEvents\":[\n";
+    bool primero = true;
+    for (const auto& e : eventos) {
+        out << (primero ? "" : ",\n")
+            << "{\"name\":\"" << e.nombre << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.hilo
+            << ",\"ts\":" << Us{e.inicio} << ",\"dur\":" << Us{e.duracion} << "}";
+        primero = false;
+
+        // Contadores acumulados al cerrar cada fase
+        out << ",\n{\"name\":\"contadores\",\"ph\":\"C\",\"pid\":1,\"ts\":"
+            << Us{e.inicio + e.duracion} << ",\"args\":{";
+        for (int i = 0; i < NUM_CONTADORES; ++i) {
+            out << (i ? "," : "") << "\"" << nombresContadores[i] << "\":" << e.contadores[i];
+        }
+        out << "}}";
+    }
+    out << "\n],\"otherData\":{\"eventos_descartados\":" << eventosDescartados;
+    for (int i = 0; i < NUM_CONTADORES; ++i) {
+        out << ",\"" << nombresContadores[i] << "\":" << valor((Contador)i);
+    }
+    out << "}}\n";
+    return true;
+}
+
+}
+
+#endif
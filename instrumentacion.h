@@ -0,0 +1,69 @@
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+// Instrumentacion opcional de los motores. Solo existe si se compila con
+// -DSCHED_INSTRUMENTACION (make INSTRUMENTAR=1); en caso contrario las macros
+// no generan codigo.
+#include <cstdint>
+#include <string>
+
+#ifdef SCHED_INSTRUMENTACION
+
+namespace instr {
+
+enum Contador {
+    ITERACIONES_SELECCION,
+    PUSH_COLA,
+    POP_COLA,
+    LLAMADAS_CALLBACK,
+    ADICIONES_TIMELINE,
+    NS_SELECCION,
+    NS_CALLBACK,
+    NUM_CONTADORES
+};
+
+void contar(Contador c, uint64_t n = 1);
+uint64_t valor(Contador c);
+void reiniciar();
+
+// Temporizador con alcance: registra un evento de duracion para la traza
+class Fase {
+public:
+    explicit Fase(const char* nombre);
+    ~Fase();
+private:
+    const char* nombre;
+    uint64_t inicio;
+};
+
+// Temporizador con alcance que solo suma nanosegundos a un contador
+class Acumulador {
+public:
+    explicit Acumulador(Contador c);
+    ~Acumulador();
+private:
+    Contador contador;
+    uint64_t inicio;
+};
+
+// Escribe las fases y contadores en formato Chrome trace (chrome://tracing, Perfetto)
+bool exportarTrazaChrome(const std::string& archivo);
+
+}
+
+#define INSTR_CONCAT_(a, b) a##b
+#define INSTR_CONCAT(a, b) INSTR_CONCAT_(a, b)
+#define INSTR_CONTAR(c) instr::contar(instr::c)
+#define INSTR_CONTAR_N(c, n) instr::contar(instr::c, (n))
+#define INSTR_FASE(nombre) instr::Fase INSTR_CONCAT(instrFase_, __LINE__)(nombre)
+#define INSTR_ACUMULAR(c) instr::Acumulador INSTR_CONCAT(instrAcum_, __LINE__)(instr::c)
+
+#else
+
+#define INSTR_CONTAR(c) ((void)0)
+#define INSTR_CONTAR_N(c, n) ((void)0)
+#define INSTR_FASE(nombre) ((void)0)
+#define INSTR_ACUMULAR(c) ((void)0)
+
+#endif
+
+#endif
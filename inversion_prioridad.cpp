@@ -0,0 +1,367 @@
+#include "inversion_prioridad.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
+#include <algorithm>
+
+const char* const NOMBRES_PROTOCOLO[3] = {"Sin protocolo", "Herencia de prioridad", "Techo de prioridad"};
+
+namespace {
+
+struct Retencion {
+    int recurso;
+    int restante;                 // Ciclos de CPU que faltan para liberarlo
+};
+
+struct EstadoProceso {
+    int base;
+    int efectiva;
+    int llegada;
+    int restante;
+    bool terminado = false;
+    int esperando = -1;           // Recurso por el que está bloqueado
+    int inicioBloqueo = 0;
+    std::vector<int> acciones;    // Índices en acciones, por ciclo
+    size_t siguiente = 0;
+    std::vector<Retencion> retenidos;
+    int episodio = -1;            // Episodio de inversión abierto, en resultado.inversiones
+};
+
+class SimuladorInversion {
+public:
+    SimuladorInversion(const std::vector<Proceso>& procesos, std::map<std::string, Recurso>& recursos,
+                       const std::vector<Accion>& acciones, const OpcionesInversion& opciones)
+        : procesos(procesos), recursos(recursos), acciones(acciones), opciones(opciones) {
+        std::map<std::string, int> indiceProceso;
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            const Proceso& p = procesos[i];
+            indiceProceso.emplace(p.pid, (int)i);
+            EstadoProceso e;
+            e.base = e.efectiva = p.priority;
+            e.llegada = p.arrival_time;
+            e.restante = cpuTotal(p);
+            estados.push_back(std::move(e));
+
+            BloqueoProceso b;
+            b.pid = p.pid;
+            b.prioridad = p.priority;
+            resultado.procesos.push_back(b);
+        }
+
+        std::vector<size_t> orden(acciones.size());
+        for (size_t i = 0; i < orden.size(); ++i) orden[i] = i;
+        std::stable_sort(orden.begin(), orden.end(),
+                         [&](size_t a, size_t b) { return acciones[a].ciclo < acciones[b].ciclo; });
+        std::map<std::string, int> indiceRecurso;
+        recursoDe.assign(acciones.size(), -1);
+        for (size_t i : orden) {
+            const Accion& a = acciones[i];
+            auto p = indiceProceso.find(a.pid);
+            if (a.ciclo < 0 || p == indiceProceso.end()) continue;
+            auto [r, nuevo] = indiceRecurso.emplace(a.recurso, (int)nombres.size());
+            if (nuevo) {
+                nombres.push_back(a.recurso);
+                techo.push_back(INT_MAX);
+            }
+            recursoDe[i] = r->second;
+            techo[r->second] = std::min(techo[r->second], estados[p->second].base);
+            estados[p->second].acciones.push_back((int)i);
+        }
+        dueno.assign(nombres.size(), -1);
+        cola.resize(nombres.size());
+
+        for (auto& [nombre, r] : recursos) {
+            r.ocupado = false;
+            r.proceso_actual = "";
+        }
+        for (const auto& nombre : nombres) recursos[nombre]; // Los no declarados se crean
+    }
+
+    ResultadoInversion correr(UpdateCallback& updateGUI, const SimulationConfig& config) {
+        resultado.protocolo = opciones.protocolo;
+        const int n = estados.size();
+        for (int i = 0; i < n; ++i) {
+            if (estados[i].restante <= 0) terminar(i, estados[i].llegada);
+        }
+
+        const bool emitir = updateGUI || config.traza;
+        int actual = -1;
+        for (int t = 0; terminados < n; ++t) {
+            if (corridaCancelada(config)) {
+                resultado.cancelado = true;
+                return resultado;
+            }
+
+            int elegido = -1;
+            while (true) {
+                actualizarPrioridades();
+                elegido = elegir(t, actual);
+                if (elegido < 0) break;
+                // Las acciones vencidas se piden al tomar la CPU
+                int r = pedirRecursos(elegido, t);
+                if (r < 0) break;
+                if (emitir) {
+                    publicar(procesos[elegido].pid + "-LOCK-" + nombres[r] + "-WAITING", nombres[r], t, updateGUI,
+                             config);
+                }
+            }
+
+            if (elegido < 0) {
+                if (interbloqueado(t)) {
+                    resultado.interbloqueo = true;
+                    break;
+                }
+                actual = -1;
+                if (emitir) publicar("IDLE", "", t, updateGUI, config);
+                if (updateGUI && pausaAnimacion(config, 300)) {
+                    resultado.cancelado = true;
+                    return resultado;
+                }
+                continue;
+            }
+
+            contarInversiones(elegido, t);
+            actual = elegido;
+            if (emitir) publicar(contenidoCiclo(elegido), "", t, updateGUI, config);
+            ejecutar(elegido, t);
+            resultado.makespan = t + 1;
+            if (updateGUI && pausaAnimacion(config, 300)) {
+                resultado.cancelado = true;
+                return resultado;
+            }
+        }
+        return resultado;
+    }
+
+private:
+    // Prioridad efectiva según el protocolo; la herencia se propaga por
+    // cadenas de bloqueo hasta que nada cambia
+    void actualizarPrioridades() {
+        for (auto& e : estados) {
+            e.efectiva = e.base;
+            if (opciones.protocolo == ProtocoloPrioridad::TECHO) {
+                for (const Retencion& r : e.retenidos) e.efectiva = std::min(e.efectiva, techo[r.recurso]);
+            }
+        }
+        if (opciones.protocolo != ProtocoloPrioridad::HERENCIA) return;
+        for (bool cambio = true; cambio;) {
+            cambio = false;
+            for (const auto& e : estados) {
+                if (e.terminado || e.esperando < 0) continue;
+                EstadoProceso& d = estados[dueno[e.esperando]];
+                if (e.efectiva < d.efectiva) {
+                    d.efectiva = e.efectiva;
+                    cambio = true;
+                }
+            }
+        }
+    }
+
+    // Mayor prioridad efectiva entre los listos. En empate sigue el que
+    // corría y luego el que retiene recursos: con techo, así nadie le quita
+    // la CPU a un dueño con su misma prioridad y no hay interbloqueos.
+    int elegir(int t, int actual) const {
+        int elegido = -1;
+        auto rango = [&](int i) { return i == actual ? 0 : estados[i].retenidos.empty() ? 2 : 1; };
+        for (int i = 0; i < (int)estados.size(); ++i) {
+            const EstadoProceso& e = estados[i];
+            if (e.terminado || e.esperando >= 0 || e.llegada > t) continue;
+            if (elegido < 0 || e.efectiva < estados[elegido].efectiva ||
+                (e.efectiva == estados[elegido].efectiva && rango(i) < rango(elegido))) {
+                elegido = i;
+            }
+        }
+        return elegido;
+    }
+
+    // Toma los recursos de las acciones vencidas. Devuelve el recurso que
+    // encontró tomado (el proceso queda bloqueado) o -1 si puede correr.
+    int pedirRecursos(int i, int t) {
+        EstadoProceso& e = estados[i];
+        for (; e.siguiente < e.acciones.size(); ++e.siguiente) {
+            int idx = e.acciones[e.siguiente];
+            const Accion& a = acciones[idx];
+            if (a.ciclo > t) break;
+            int r = recursoDe[idx];
+            if (dueno[r] == i) continue; // Ya lo tiene: la sección en curso lo cubre
+            if (dueno[r] < 0) {
+                tomar(i, r);
+                continue;
+            }
+            e.esperando = r;
+            e.inicioBloqueo = t;
+            cola[r].push_back(i);
+            resultado.procesos[i].bloqueos++;
+            return r;
+        }
+        return -1;
+    }
+
+    void tomar(int i, int r) {
+        dueno[r] = i;
+        estados[i].retenidos.push_back({r, std::max(1, opciones.ciclosSeccion)});
+        Recurso& recurso = recursos[nombres[r]];
+        recurso.ocupado = true;
+        recurso.proceso_actual = procesos[i].pid;
+    }
+
+    // Se entrega directamente al de mayor prioridad efectiva de la cola (FIFO en empate)
+    void liberar(int r, int t) {
+        dueno[r] = -1;
+        Recurso& recurso = recursos[nombres[r]];
+        recurso.ocupado = false;
+        recurso.proceso_actual = "";
+        if (cola[r].empty()) return;
+
+        auto mejor = std::min_element(cola[r].begin(), cola[r].end(),
+                                      [&](int a, int b) { return estados[a].efectiva < estados[b].efectiva; });
+        int w = *mejor;
+        cola[r].erase(mejor);
+        EstadoProceso& e = estados[w];
+        e.esperando = -1;
+        e.siguiente++;
+        e.episodio = -1;
+        int duracion = t - e.inicioBloqueo;
+        BloqueoProceso& b = resultado.procesos[w];
+        b.ciclosBloqueado += duracion;
+        b.maxBloqueo = std::max(b.maxBloqueo, duracion);
+        resultado.bloqueo.agregar(duracion);
+        tomar(w, r);
+    }
+
+    void terminar(int i, int t) {
+        EstadoProceso& e = estados[i];
+        e.terminado = true;
+        terminados++;
+        resultado.procesos[i].completion = t;
+        std::vector<Retencion> retenidos;
+        retenidos.swap(e.retenidos);
+        for (const Retencion& r : retenidos) liberar(r.recurso, t);
+    }
+
+    void ejecutar(int i, int t) {
+        EstadoProceso& e = estados[i];
+        e.restante--;
+        std::vector<int> liberados;
+        for (auto it = e.retenidos.begin(); it != e.retenidos.end();) {
+            if (--it->restante > 0) {
+                ++it;
+                continue;
+            }
+            liberados.push_back(it->recurso);
+            it = e.retenidos.erase(it);
+        }
+        for (int r : liberados) liberar(r, t + 1);
+        if (e.restante <= 0) terminar(i, t + 1);
+    }
+
+    // ¿Está `j` en la cadena que bloquea a `i` (dueño, el dueño de lo que
+    // espera el dueño, ...)?
+    bool enCadena(int i, int j) const {
+        int r = estados[i].esperando;
+        for (size_t pasos = 0; r >= 0 && pasos < estados.size(); ++pasos) {
+            int d = dueno[r];
+            if (d == j) return true;
+            r = estados[d].esperando;
+        }
+        return false;
+    }
+
+    void contarInversiones(int corriendo, int t) {
+        for (int h = 0; h < (int)estados.size(); ++h) {
+            EstadoProceso& e = estados[h];
+            if (e.terminado || e.esperando < 0) continue;
+            if (estados[corriendo].base <= e.base || enCadena(h, corriendo)) {
+                e.episodio = -1;
+                continue;
+            }
+            resultado.procesos[h].ciclosInversion++;
+            resultado.ciclosInversion++;
+            if (e.episodio >= 0) {
+                EpisodioInversion& ep = resultado.inversiones[e.episodio];
+                if (ep.fin == t && ep.intruso == procesos[corriendo].pid) {
+                    ep.fin = t + 1;
+                    continue;
+                }
+            }
+            e.episodio = resultado.inversiones.size();
+            resultado.inversiones.push_back({procesos[h].pid, procesos[dueno[e.esperando]].pid,
+                                             procesos[corriendo].pid, nombres[e.esperando], t, t + 1});
+        }
+    }
+
+    // Sin nadie listo: interbloqueo si los que faltan ya llegaron y todos esperan
+    bool interbloqueado(int t) const {
+        bool alguienEspera = false;
+        for (const auto& e : estados) {
+            if (e.terminado) continue;
+            if (e.llegada > t) return false;
+            alguienEspera |= e.esperando >= 0;
+        }
+        return alguienEspera;
+    }
+
+    std::string contenidoCiclo(int i) const {
+        const EstadoProceso& e = estados[i];
+        std::string tomados;
+        for (const Retencion& r : e.retenidos) {
+            tomados += (tomados.empty() ? "" : ",") + nombres[r.recurso];
+        }
+        return procesos[i].pid + "-CPU-" + (tomados.empty() ? "libre" : tomados) + "-P" +
+               std::to_string(e.efectiva);
+    }
+
+    // Los ciclos de CPU van al track de CPU de la traza; los bloqueos, al del recurso
+    void publicar(const std::string& contenido, const std::string& recurso, int t, UpdateCallback& updateGUI,
+                  const SimulationConfig& config) {
+        if (config.traza) {
+            if (recurso.empty()) config.traza->ciclo(contenido, t);
+            else config.traza->eventoSync(recurso, contenido, t);
+        }
+        if (updateGUI) updateGUI(contenido, t);
+    }
+
+    const std::vector<Proceso>& procesos;
+    std::map<std::string, Recurso>& recursos;
+    const std::vector<Accion>& acciones;
+    OpcionesInversion opciones;
+
+    std::vector<EstadoProceso> estados;
+    std::vector<std::string> nombres;        // Recursos usados por alguna acción
+    std::vector<int> techo;                  // Mayor prioridad (menor número) entre quienes lo usan
+    std::vector<int> dueno;
+    std::vector<std::vector<int>> cola;      // Bloqueados por recurso, en orden de llegada
+    std::vector<int> recursoDe;              // Por acción; -1 si se ignora
+    int terminados = 0;
+    ResultadoInversion resultado;
+};
+
+}
+
+ResultadoInversion simularInversionPrioridad(const std::vector<Proceso>& procesos,
+                                             std::map<std::string, Recurso>& recursos,
+                                             const std::vector<Accion>& acciones, const OpcionesInversion& opciones,
+                                             UpdateCallback updateGUI, const SimulationConfig& config) {
+    INSTR_FASE("inversion_prioridad");
+    SimuladorInversion simulador(procesos, recursos, acciones, opciones);
+    return simulador.correr(updateGUI, config);
+}
+
+std::vector<ResultadoInversion> compararProtocolos(const std::vector<Proceso>& procesos,
+                                                   const std::map<std::string, Recurso>& recursos,
+                                                   const std::vector<Accion>& acciones, int ciclosSeccion,
+                                                   const TokenCancelacion* cancelacion) {
+    std::vector<ResultadoInversion> resultados;
+    SimulationConfig config;
+    config.cancelacion = cancelacion;
+    for (ProtocoloPrioridad protocolo :
+         {ProtocoloPrioridad::NINGUNO, ProtocoloPrioridad::HERENCIA, ProtocoloPrioridad::TECHO}) {
+        OpcionesInversion opciones;
+        opciones.protocolo = protocolo;
+        opciones.ciclosSeccion = ciclosSeccion;
+        std::map<std::string, Recurso> copia = recursos;
+        ResultadoInversion r = simularInversionPrioridad(procesos, copia, acciones, opciones, nullptr, config);
+        if (r.cancelado) return {};
+        resultados.push_back(std::move(r));
+    }
+    return resultados;
+}
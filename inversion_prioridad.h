@@ -0,0 +1,76 @@
+#ifndef INVERSION_PRIORIDAD_H
+#define INVERSION_PRIORIDAD_H
+#include "scheduler.h"
+
+// Calendarización por prioridad (expropiativa, menor número = mayor
+// prioridad) de procesos.txt mientras los procesos toman los recursos de
+// acciones.txt. Cada recurso se trata como un mutex: una acción pide su
+// recurso la primera vez que el proceso está en CPU en un ciclo >= al de la
+// acción, y lo retiene ciclosSeccion ciclos de su propia CPU. Si lo expropian
+// con el recurso tomado, lo sigue reteniendo: es la situación en la que un
+// proceso de prioridad intermedia puede dejar bloqueado a uno de mayor
+// prioridad (inversión de prioridad).
+//
+// Las ráfagas de E/S no se simulan: cada proceso ejecuta cpuTotal ciclos.
+enum class ProtocoloPrioridad {
+    NINGUNO,   // Cada proceso corre con su prioridad base
+    HERENCIA,  // El dueño hereda la prioridad de quien espera sus recursos (transitivo)
+    TECHO      // Techo inmediato: el dueño sube a la mayor prioridad de quienes usan el recurso
+};
+
+extern const char* const NOMBRES_PROTOCOLO[3];
+
+struct OpcionesInversion {
+    ProtocoloPrioridad protocolo = ProtocoloPrioridad::NINGUNO;
+    int ciclosSeccion = 3;        // Ciclos de CPU con el recurso tomado
+};
+
+struct BloqueoProceso {
+    std::string pid;
+    int prioridad = 0;
+    int bloqueos = 0;             // Veces que encontró su recurso tomado
+    int ciclosBloqueado = 0;
+    int maxBloqueo = 0;
+    int ciclosInversion = 0;      // Ciclos bloqueado mientras corría un proceso de menor prioridad ajeno al bloqueo
+    int completion = -1;          // -1 si no terminó (interbloqueo)
+};
+
+// Ciclos consecutivos en que `intruso` corrió mientras `bloqueado`, de mayor
+// prioridad, esperaba el recurso de `dueno`
+struct EpisodioInversion {
+    std::string bloqueado;
+    std::string dueno;
+    std::string intruso;
+    std::string recurso;
+    int inicio;
+    int fin;                      // Exclusivo
+};
+
+struct ResultadoInversion {
+    ProtocoloPrioridad protocolo = ProtocoloPrioridad::NINGUNO;
+    std::vector<BloqueoProceso> procesos;      // En el orden de procesos.txt
+    std::vector<EpisodioInversion> inversiones;
+    SketchCuantiles bloqueo;                   // Duración de cada bloqueo
+    int ciclosInversion = 0;
+    int makespan = 0;
+    bool interbloqueo = false;                 // Quedaron procesos esperándose entre sí
+    bool cancelado = false;
+};
+
+// Con updateGUI, cada ciclo se publica como "pid-CPU-recursos-Pn" (n es la
+// prioridad efectiva) y cada bloqueo como "pid-LOCK-recurso-WAITING". El
+// estado de `recursos` (ocupado, proceso_actual) se mantiene al día para
+// que el callback pueda mostrarlo.
+ResultadoInversion simularInversionPrioridad(const std::vector<Proceso>& procesos,
+                                             std::map<std::string, Recurso>& recursos,
+                                             const std::vector<Accion>& acciones, const OpcionesInversion& opciones,
+                                             UpdateCallback updateGUI = nullptr,
+                                             const SimulationConfig& config = SimulationConfig());
+
+// Los tres protocolos sobre la misma entrada, sin animación; vacío si se cancela
+std::vector<ResultadoInversion> compararProtocolos(const std::vector<Proceso>& procesos,
+                                                   const std::map<std::string, Recurso>& recursos,
+                                                   const std::vector<Accion>& acciones, int ciclosSeccion,
+                                                   const TokenCancelacion* cancelacion = nullptr);
+
+#endif
@@ -0,0 +1,110 @@
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
+#include <algorithm>
+
+void ArbolFenwick::reiniciar(int n) {
+    arbol.assign(n + 1, 0);
+    total_ = 0;
+    escalon = 1;
+    while (escalon * 2 <= n) escalon *= 2;
+}
+
+void ArbolFenwick::sumar(int i, long long delta) {
+    total_ += delta;
+    for (++i; i < (int)arbol.size(); i += i & -i) {
+        arbol[i] += delta;
+    }
+}
+
+// Desciende por potencias de 2 acumulando mientras no se pase de r
+int ArbolFenwick::buscar(long long r) const {
+    int pos = 0;
+    for (int paso = escalon; paso > 0; paso >>= 1) {
+        if (pos + paso < (int)arbol.size() && arbol[pos + paso] <= r) {
+            pos += paso;
+            r -= arbol[pos];
+        }
+    }
+    return pos;
+}
+
+namespace {
+uint64_t siguienteAzar(uint64_t& estado) {
+    uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}
+
+void SeleccionLottery::preparar(EstadoMotor& e) {
+    porLlegada.resize(e.procesos.size());
+    for (int i = 0; i < (int)porLlegada.size(); ++i) porLlegada[i] = i;
+    std::stable_sort(porLlegada.begin(), porLlegada.end(), [&e](int a, int b) {
+        return e.procesos[a].arrival_time < e.procesos[b].arrival_time;
+    });
+    arbol.reiniciar(e.procesos.size());
+}
+
+void SeleccionLottery::admitir(EstadoMotor& e) {
+    while (siguiente < (int)porLlegada.size() && e.procesos[porLlegada[siguiente]].arrival_time <= e.tiempo) {
+        int idx = porLlegada[siguiente++];
+        e.procesos[idx].en_cola = true;
+        arbol.sumar(idx, boletos(e.procesos[idx]));
+        listos++;
+    }
+}
+
+int SeleccionLottery::seleccionar(EstadoMotor& e) {
+    admitir(e);
+    if (listos == 0) {
+        return -1;
+    }
+
+    int idx = arbol.buscar((long long)(siguienteAzar(azar) % (uint64_t)arbol.total()));
+    arbol.sumar(idx, -boletos(e.procesos[idx]));
+    listos--;
+    INSTR_CONTAR(POP_COLA);
+    if (e.config.traza) {
+        e.config.traza->colaListos(e.tiempo, listos);
+    }
+    return idx;
+}
+
+void SeleccionLottery::alExpropiar(EstadoMotor& e, int idx) {
+    arbol.sumar(idx, boletos(e.procesos[idx]));
+    listos++;
+    INSTR_CONTAR(PUSH_COLA);
+}
+
+void SeleccionLottery::alVolverDeES(EstadoMotor& e, int idx) {
+    alExpropiar(e, idx);
+}
+
+void SeleccionLottery::guardar(std::vector<int>& extra) const {
+    extra.push_back((int)(uint32_t)azar);
+    extra.push_back((int)(uint32_t)(azar >> 32));
+}
+
+// En el árbol quedan los admitidos que esperan el CPU
+void SeleccionLottery::restaurar(const EstadoMotor& e, const std::vector<int>& extra) {
+    azar = extra.size() < 2 ? SEMILLA : (uint64_t)(uint32_t)extra[0] | ((uint64_t)(uint32_t)extra[1] << 32);
+    arbol.reiniciar(e.procesos.size());
+    siguiente = 0;
+    listos = 0;
+    for (int i = 0; i < (int)e.procesos.size(); ++i) {
+        const Proceso& p = e.procesos[i];
+        if (p.en_cola || p.terminado) siguiente++;
+        if (p.en_cola && !p.terminado && !p.en_es && i != e.actual) {
+            arbol.sumar(i, boletos(p));
+            listos++;
+        }
+    }
+}
+
+SimulationResult lottery(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI,
+                         const SimulationConfig& config) {
+    return correrPoliticas(procesos, std::move(updateGUI), config, SeleccionLottery{},
+                           ExpropiacionPorQuantum{quantum});
+}
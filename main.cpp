@@ -9,6 +9,8 @@
 #include <wx/timer.h>
 #include <wx/listctrl.h>
 #include <wx/statline.h>
+#include <wx/progdlg.h>
+#include <wx/numdlg.h>
 #include <vector>
 #include <map>
 #include <queue>
@@ -18,48 +20,66 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <random>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
 #include "scheduler.h"
+#include "motor.h"
+#include "instrumentacion.h"
+#include "cancelacion.h"
+#include "historial_gantt.h"
+#include "montecarlo.h"
+#include "importador_sched.h"
+#include "contencion_real.h"
+#include "sincronizacion.h"
+#include "inversion_prioridad.h"
+#include "exportar_gantt.h"
+#include "archivo_resultados.h"
+#include "traza_simulacion.h"
 
 // Estructura para almacenar datos de un algoritmo
 struct AlgorithmData {
     std::string name;
-    std::vector<std::pair<std::string, int>> timeline;
-    std::vector<Proceso> procesos;
-    SimulationResult result;
+    HistorialGantt timeline;       // Memoria acotada; lo antiguo se va a disco
+    ResultadoCompartido result;    // Se comparte, no se copia
+    ProcesosCompartidos procesos;
     int trackIndex;
+    // Track abierto desde un archivo de resultados: timeline y procesos se
+    // leen del archivo mapeado y los dos campos anteriores quedan vacíos
+    std::shared_ptr<const ArchivoResultados> archivo;
+    size_t trackArchivo = 0;
 };
 
 // Panel de Diagrama de Gantt MULTI-ALGORITMO
+//
+// El ancho del contenido (150 + ranuras * blockWidth) no cabe en un int a
+// partir de unos 30 millones de ciclos. La barra horizontal trabaja sobre un
+// ancho virtual acotado a ANCHO_VIRTUAL_MAX y su posición se traduce a un
+// desplazamiento de 64 bits dentro del contenido; las posiciones se dibujan
+// relativas a ese desplazamiento, así que siempre caben en la ventana.
 class GanttPanel : public wxScrolledWindow {
 private:
-    struct TimeSlot {
-        std::string content;
-        int cycle;
-        bool isWaiting;
-        bool isIdle;
-        std::string processId;
-        std::string resource;
-        std::string action;
-        std::string status;
-        int trackIndex; 
-    };
+    static constexpr int ANCHO_VIRTUAL_MAX = 1 << 30;
     
-    std::vector<TimeSlot> timeline;
     std::map<std::string, wxColour> processColors;
     std::vector<AlgorithmData> algorithms; 
-    int currentCycle = 0;
     int blockWidth = 70;  
     int blockHeight = 50;  
     int trackHeight = 100;  
     int trackSeparation = 30; // Separación entre tracks
     bool isSync = false;
+    int cursorCycle = -1;     // Ciclo marcado por el scrubber (-1 = sin marca)
     
 public:
     GanttPanel(wxWindow* parent) : wxScrolledWindow(parent) {
         SetBackgroundStyle(wxBG_STYLE_PAINT);
         SetVirtualSize(800, 200);
         SetScrollRate(10, 10); // Permitir scroll vertical también
+        // El contenido no se mueve píxel a píxel con la barra cuando el
+        // ancho está escalado: se redibuja en vez de desplazar la ventana
+        EnableScrolling(false, true);
         Bind(wxEVT_PAINT, &GanttPanel::OnPaint, this);
     }
     
@@ -69,7 +89,7 @@ public:
         AlgorithmData newAlgorithm;
         newAlgorithm.name = algorithmName;
         newAlgorithm.trackIndex = algorithms.size();
-        algorithms.push_back(newAlgorithm);
+        algorithms.push_back(std::move(newAlgorithm));
         
         // Ajustar tamaño virtual para incluir nuevos tracks
         int totalHeight = (algorithms.size() * trackHeight) + 100;
@@ -78,80 +98,97 @@ public:
     }
     
     void AddTimeSlot(const std::string& content, int cycle) {
-        TimeSlot slot;
-        slot.content = content;
-        slot.cycle = cycle;
-        slot.isIdle = (content == "CPU IDLE" || content == "IDLE");
-        slot.isWaiting = (content.find("WAITING") != std::string::npos);
-        slot.trackIndex = algorithms.empty() ? 0 : algorithms.size() - 1; // Track actual
-        
-        // Parsear contenido para modo sincronización
-        if (isSync && !slot.isIdle) {
-            std::vector<std::string> parts;
-            std::stringstream ss(content);
-            std::string part;
-            
-            while (std::getline(ss, part, '-')) {
-                parts.push_back(part);
-            }
-            
-            if (parts.size() >= 4) {
-                slot.processId = parts[0];
-                slot.action = parts[1];
-                slot.resource = parts[2];
-                slot.status = parts[3];
-            }
-        } else if (!isSync) {
-            slot.processId = content;
+        AppendTimeSlot(content, cycle);
+        ShowLatest();
+    }
+    
+    // Guarda la ranura sin redibujar; quien agrega muchas seguidas llama a
+    // ShowLatest() una vez al final
+    void AppendTimeSlot(const std::string& content, int cycle) {
+        // En modo sincronización los bloques IDLE no se dibujan, así que no se guardan
+        if (isSync && (content == "CPU IDLE" || content == "IDLE")) {
+            return;
         }
         
-        timeline.push_back(slot);
-        currentCycle = cycle;
-        
-        // Agregar al algoritmo actual también
+        // Agregar al algoritmo actual
         if (!algorithms.empty()) {
-            algorithms.back().timeline.push_back({content, cycle});
+            algorithms.back().timeline.agregar(content, cycle);
         }
-        
+    }
+    
+    // Ajusta el ancho virtual, redibuja y se desplaza a la última ranura
+    void ShowLatest() {
         // Calcular ancho requerido para este track
-        int maxTimeSlots = 0;
-        for (const auto& algo : algorithms) {
-            maxTimeSlots = std::max(maxTimeSlots, (int)algo.timeline.size());
-        }
-        
-        int requiredWidth = (maxTimeSlots + 2) * blockWidth + 200; // +200 para etiquetas
+        int requiredWidth = VirtualWidth();
         if (requiredWidth > GetVirtualSize().GetWidth()) {
             SetVirtualSize(requiredWidth, GetVirtualSize().GetHeight());
         }
         
         Refresh();
         // Auto-scroll al final horizontalmente
-        int scrollUnits = std::max(0, (requiredWidth / 10) - (GetClientSize().GetWidth() / 10));
-        Scroll(scrollUnits, GetViewStart().y);
+        ScrollToPixel(ContentWidth() - GetClientSize().GetWidth());
     }
     
-    void FinishCurrentAlgorithm(const SimulationResult& result, const std::vector<Proceso>& procesos) {
-        if (!algorithms.empty()) {
-            algorithms.back().result = result;
-            algorithms.back().procesos = procesos;
-        }
+    // Agrega un track leído de un archivo de resultados; no copia ranuras
+    void AddSavedAlgorithm(std::shared_ptr<const ArchivoResultados> archivo, size_t track) {
+        AlgorithmData saved;
+        saved.name = archivo->nombre(track);
+        saved.result = archivo->resultado(track);
+        saved.trackIndex = algorithms.size();
+        saved.archivo = std::move(archivo);
+        saved.trackArchivo = track;
+        algorithms.push_back(std::move(saved));
+        
+        SetVirtualSize(std::max(GetVirtualSize().GetWidth(), VirtualWidth()),
+                       (algorithms.size() * trackHeight) + 100);
+        Refresh();
+    }
+    
+    // Publica el resultado del track actual. El timeline se queda en el
+    // historial del track, que es la única copia
+    const AlgorithmData& FinishCurrentAlgorithm(SimulationResult&& result, std::vector<Proceso>&& procesos) {
+        AlgorithmData& current = algorithms.back();
+        current.result = std::make_shared<const SimulationResult>(std::move(result));
+        current.procesos = std::make_shared<const std::vector<Proceso>>(std::move(procesos));
+        return current;
     }
      
+    // Marca un ciclo en todos los tracks y desplaza la vista hasta él
+    void SetCursorCycle(int cycle) {
+        cursorCycle = cycle;
+        if (cycle >= 0) {
+            ScrollToPixel(150 + (long long)cycle * blockWidth - GetClientSize().GetWidth() / 2);
+        }
+        Refresh();
+    }
+    
     void Clear() {
-        timeline.clear();
         algorithms.clear();
-        currentCycle = 0;
+        cursorCycle = -1;
         SetVirtualSize(800, 200);
         Refresh();
     }
     
     void OnPaint(wxPaintEvent& event) {
         wxAutoBufferedPaintDC dc(this);
-        DoPrepareDC(dc);
+        
+        // Solo el eje vertical usa el origen del DC; el horizontal se resuelve
+        // aquí porque el contenido puede ser más ancho que un int
+        int viewX, viewY, unitX, unitY;
+        GetViewStart(&viewX, &viewY);
+        GetScrollPixelsPerUnit(&unitX, &unitY);
+        dc.SetDeviceOrigin(0, -viewY * unitY);
         
         dc.Clear();
         dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
         
+        // Rango horizontal visible en píxeles del contenido
+        int clientWidth = GetClientSize().GetWidth();
+        long long visibleLeft = PixelFromScroll(viewX * unitX);
+        long long visibleRight = visibleLeft + clientWidth;
+        // Las etiquetas de la izquierda se desplazan con el contenido
+        int labelX = 10 - (int)std::min<long long>(visibleLeft, clientWidth + 200);
+        
         // Dibujar cada algoritmo en su propio track
         for (size_t trackIdx = 0; trackIdx < algorithms.size(); trackIdx++) {
             const auto& algorithm = algorithms[trackIdx];
@@ -160,57 +197,68 @@ public:
             // Dibujar etiqueta del algoritmo
             dc.SetFont(wxFont(12, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
             dc.SetTextForeground(wxColour(0, 0, 0));
-            dc.DrawText(algorithm.name, 10, trackY - 30);
+            dc.DrawText(algorithm.name, labelX, trackY - 30);
             
             // Dibujar métricas básicas del algoritmo
-            if (algorithm.result.avgWaitingTime >= 0) {
+            if (algorithm.result && algorithm.result->avgWaitingTime >= 0) {
                 dc.SetFont(wxFont(9, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
                 dc.SetTextForeground(wxColour(100, 100, 100));
-                wxString metricsText = wxString::Format("Avg WT: %.2f | Avg TAT: %.2f", 
-                    algorithm.result.avgWaitingTime, algorithm.result.avgTurnaroundTime);
-                dc.DrawText(metricsText, 10, trackY - 15);
+                dc.DrawText(resumenMetricas(*algorithm.result), labelX, trackY - 15);
             }
             
-            // Dibujar timeline del algoritmo
-            int x = 150; // Offset para las etiquetas
+            // Dibujar solo las ranuras visibles; las demás pueden estar en disco
+            size_t slotCount = SlotCount(algorithm);
+            size_t first = std::min(slotCount, (size_t)std::max(0LL, (visibleLeft - 150) / blockWidth));
+            size_t last = std::min(slotCount, (size_t)std::max(0LL, (visibleRight - 150) / blockWidth + 1));
+            // Offset para las etiquetas, relativo a la primera ranura visible
+            int x = (int)(150 + (long long)first * blockWidth - visibleLeft);
             
-            for (size_t i = 0; i < algorithm.timeline.size(); i++) {
-                const auto& slot = algorithm.timeline[i];
+            for (size_t i = first; i < last; i++) {
+                const HistorialGantt::Ranura slot = SlotAt(algorithm, i);
                 
                 // Configurar colores según el contenido
-                bool isIdle = (slot.first == "CPU IDLE" || slot.first == "IDLE");
-                bool isWaiting = (slot.first.find("WAITING") != std::string::npos);
-                
-                // En modo sincronización, saltar completamente los bloques IDLE
-                if (isSync && isIdle) {
-                    continue;
-                }
+                bool isIdle = (slot.contenido == "CPU IDLE" || slot.contenido == "IDLE");
+                bool isWaiting = (slot.contenido.find("WAITING") != std::string::npos);
+                bool isSwitch = (slot.contenido == "CS");
                 
                 // Dibujar número de ciclo arriba
                 dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
                 dc.SetTextForeground(wxColour(0, 0, 0));
-                wxString cycleText = wxString::Format("C%d", slot.second);
+                wxString cycleText = wxString::Format("C%d", slot.ciclo);
                 wxSize cycleSize = dc.GetTextExtent(cycleText);
                 dc.DrawText(cycleText, x + (blockWidth - cycleSize.x) / 2, trackY - 10);
                 
                 if (isIdle) {
                     dc.SetBrush(wxBrush(wxColour(220, 220, 220)));
                     dc.SetPen(wxPen(wxColour(100, 100, 100), 1, wxPENSTYLE_SOLID));
+                } else if (isSwitch) {
+                    // Ciclo no productivo por cambio de contexto
+                    dc.SetBrush(wxBrush(wxColour(60, 60, 60), wxBRUSHSTYLE_BDIAGONAL_HATCH));
+                    dc.SetPen(wxPen(wxColour(60, 60, 60), 1, wxPENSTYLE_SOLID));
                 } else if (isWaiting) {
                     dc.SetBrush(wxBrush(wxColour(255, 200, 200)));
                     dc.SetPen(wxPen(wxColour(200, 0, 0), 2, wxPENSTYLE_DOT));
                 } else {
                     // Obtener PID para color
-                    std::string pid = slot.first;
+                    std::string pid = slot.contenido;
                     if (isSync) {
-                        size_t dashPos = slot.first.find('-');
+                        size_t dashPos = slot.contenido.find('-');
                         if (dashPos != std::string::npos) {
-                            pid = slot.first.substr(0, dashPos);
+                            pid = slot.contenido.substr(0, dashPos);
                         }
                     }
                     
-                    if (processColors.find(pid) != processColors.end()) {
-                        dc.SetBrush(wxBrush(processColors[pid]));
+                    auto color = processColors.find(pid);
+                    if (color == processColors.end() && algorithm.archivo) {
+                        // Mismo color que al cargar la carga guardada
+                        int index = algorithm.archivo->indiceProceso(algorithm.trackArchivo, pid);
+                        if (index >= 0) {
+                            ColorRGB rgb = colorProceso(index);
+                            color = processColors.emplace(pid, wxColour(rgb.r, rgb.g, rgb.b)).first;
+                        }
+                    }
+                    if (color != processColors.end()) {
+                        dc.SetBrush(wxBrush(color->second));
                     } else {
                         dc.SetBrush(wxBrush(wxColour(200, 255, 200)));
                     }
@@ -229,7 +277,7 @@ public:
                 } else if (isSync) {
                     // Información detallada para sincronización
                     std::vector<std::string> parts;
-                    std::stringstream ss(slot.first);
+                    std::stringstream ss(slot.contenido);
                     std::string part;
                     while (std::getline(ss, part, '-')) {
                         parts.push_back(part);
@@ -251,8 +299,8 @@ public:
                 } else {
                     // Solo PID para calendarización
                     dc.SetTextForeground(wxColour(0, 0, 0));
-                    wxSize textSize = dc.GetTextExtent(slot.first);
-                    dc.DrawText(slot.first, x + (blockWidth - textSize.x) / 2, trackY + (blockHeight - textSize.y) / 2);
+                    wxSize textSize = dc.GetTextExtent(slot.contenido);
+                    dc.DrawText(slot.contenido, x + (blockWidth - textSize.x) / 2, trackY + (blockHeight - textSize.y) / 2);
                 }
                 
                 x += blockWidth;
@@ -261,10 +309,16 @@ public:
             // Línea separadora entre tracks
             if (trackIdx < algorithms.size() - 1) {
                 dc.SetPen(wxPen(wxColour(200, 200, 200), 1, wxPENSTYLE_SOLID));
-                dc.DrawLine(0, trackY + blockHeight + trackSeparation/2, GetVirtualSize().GetWidth(), trackY + blockHeight + trackSeparation/2);
+                dc.DrawLine(0, trackY + blockHeight + trackSeparation/2, clientWidth, trackY + blockHeight + trackSeparation/2);
             }
         }
         
+        long long cursorX = 150 + (long long)cursorCycle * blockWidth + blockWidth / 2 - visibleLeft;
+        if (cursorCycle >= 0 && !isSync && !algorithms.empty() && cursorX >= 0 && cursorX <= clientWidth) {
+            dc.SetPen(wxPen(wxColour(220, 0, 0), 2, wxPENSTYLE_SOLID));
+            dc.DrawLine((int)cursorX, 20, (int)cursorX, 50 + algorithms.size() * trackHeight);
+        }
+        
         // Leyenda para modo sincronización (solo si hay algoritmos)
         if (isSync && !algorithms.empty()) {
             int legendY = 50 + algorithms.size() * trackHeight + 20;
@@ -273,15 +327,15 @@ public:
             // ACCESSED
             dc.SetBrush(wxBrush(wxColour(200, 255, 200)));
             dc.SetPen(wxPen(wxColour(0, 150, 0), 2));
-            dc.DrawRectangle(10, legendY, 20, 15);
+            dc.DrawRectangle(labelX, legendY, 20, 15);
             dc.SetTextForeground(wxColour(0, 0, 0));
-            dc.DrawText("ACCESSED", 35, legendY + 2);
+            dc.DrawText("ACCESSED", labelX + 25, legendY + 2);
             
             // WAITING
             dc.SetBrush(wxBrush(wxColour(255, 200, 200)));
             dc.SetPen(wxPen(wxColour(200, 0, 0), 2, wxPENSTYLE_DOT));
-            dc.DrawRectangle(120, legendY, 20, 15);
-            dc.DrawText("WAITING", 145, legendY + 2);
+            dc.DrawRectangle(labelX + 110, legendY, 20, 15);
+            dc.DrawText("WAITING", labelX + 135, legendY + 2);
         }
     }
     
@@ -289,11 +343,216 @@ public:
         processColors[processId] = color;
     }
     
-    std::vector<AlgorithmData> GetAlgorithmsData() const {
+    const std::vector<AlgorithmData>& GetAlgorithmsData() const {
         return algorithms;
     }
+    
+    // Los tracks leen directamente de los historiales; el panel debe seguir
+    // vivo (y sin limpiarse) mientras se exporta
+    std::vector<TrackGantt> GetExportTracks() const {
+        std::vector<TrackGantt> tracks;
+        for (const auto& algorithm : algorithms) {
+            std::string metricas;
+            if (algorithm.result && algorithm.result->avgWaitingTime >= 0) {
+                metricas = resumenMetricas(*algorithm.result);
+            }
+            if (algorithm.archivo) {
+                auto archivo = algorithm.archivo;
+                size_t track = algorithm.trackArchivo;
+                tracks.push_back({algorithm.name, metricas, archivo->ranuras(track),
+                                  [archivo, track](size_t i) { return archivo->ranura(track, i); }});
+            } else {
+                tracks.push_back(trackDesdeHistorial(algorithm.name, algorithm.timeline, metricas));
+            }
+        }
+        return tracks;
+    }
+    
+    ColoresProceso GetExportColors() const {
+        ColoresProceso colores;
+        for (const auto& [pid, color] : processColors) {
+            colores[pid] = {color.Red(), color.Green(), color.Blue()};
+        }
+        for (const auto& algorithm : algorithms) {
+            if (!algorithm.archivo) continue;
+            for (size_t i = 0; i < algorithm.archivo->procesos(algorithm.trackArchivo); i++) {
+                std::string pid(algorithm.archivo->proceso(algorithm.trackArchivo, i).pid);
+                colores.emplace(pid, colorProceso(i));
+            }
+        }
+        return colores;
+    }
+    
+    // Tracks terminados, listos para guardarse en un archivo de resultados
+    std::vector<TrackResultados> GetSaveTracks() const {
+        std::vector<TrackResultados> tracks;
+        for (const auto& algorithm : algorithms) {
+            if (algorithm.archivo) {
+                TrackResultados track = algorithm.archivo->track(algorithm.trackArchivo);
+                track.nombre = algorithm.name;
+                tracks.push_back(std::move(track));
+            } else if (algorithm.result) {
+                tracks.push_back(trackResultados(algorithm.name, algorithm.timeline, algorithm.result, algorithm.procesos));
+            }
+        }
+        return tracks;
+    }
+    
+private:
+    size_t SlotCount(const AlgorithmData& algorithm) const {
+        return algorithm.archivo ? algorithm.archivo->ranuras(algorithm.trackArchivo) : algorithm.timeline.size();
+    }
+    
+    HistorialGantt::Ranura SlotAt(const AlgorithmData& algorithm, size_t i) const {
+        return algorithm.archivo ? algorithm.archivo->ranura(algorithm.trackArchivo, i) : algorithm.timeline.en(i);
+    }
+    
+    // Ancho del contenido para el track más largo, +200 para etiquetas
+    long long ContentWidth() const {
+        size_t maxTimeSlots = 0;
+        for (const auto& algo : algorithms) {
+            maxTimeSlots = std::max(maxTimeSlots, SlotCount(algo));
+        }
+        return ((long long)maxTimeSlots + 2) * blockWidth + 200;
+    }
+    
+    // Ancho que ve la barra de scroll; por encima del máximo cada píxel de
+    // la barra representa varios del contenido
+    int VirtualWidth() const {
+        return (int)std::min<long long>(ContentWidth(), ANCHO_VIRTUAL_MAX);
+    }
+    
+    // Fracción del recorrido: contenido desplazable / recorrido de la barra
+    double ScrollScale() const {
+        long long client = GetClientSize().GetWidth();
+        long long content = ContentWidth();
+        long long track = GetVirtualSize().GetWidth();
+        if (content <= track || track <= client) return 1.0;
+        return (double)(content - client) / (double)(track - client);
+    }
+    
+    // Posición de la barra (píxeles virtuales) -> píxel del contenido. La
+    // última unidad de scroll lleva siempre al final del contenido
+    long long PixelFromScroll(int scrollPixel) const {
+        double scale = ScrollScale();
+        if (scale > 1.0 && scrollPixel + 10 >= GetVirtualSize().GetWidth() - GetClientSize().GetWidth()) {
+            return ContentWidth() - GetClientSize().GetWidth();
+        }
+        return (long long)(scrollPixel * scale);
+    }
+    
+    void ScrollToPixel(long long pixel) {
+        long long scrollPixel = (long long)(std::max(0LL, pixel) / ScrollScale());
+        int scrollUnits = (int)std::min<long long>(scrollPixel / 10, ANCHO_VIRTUAL_MAX / 10);
+        Scroll(scrollUnits, GetViewStart().y);
+    }
 };
 
+// wxListCtrl en modo virtual: el control no guarda filas, pide a cada columna
+// el texto de las celdas visibles. Abrir una tabla cuesta O(1) sin importar
+// cuántas filas tenga; ordenar permuta índices, nunca los datos.
+class ListaVirtual : public wxListCtrl {
+public:
+    struct Columna {
+        wxString titulo;
+        int formato;
+        int ancho;
+        std::function<wxString(size_t)> texto;
+        std::function<bool(size_t, size_t)> menor;  // Vacío = columna no ordenable
+    };
+    
+private:
+    std::vector<Columna> columnas;
+    std::vector<uint32_t> orden;  // Vacío = orden original (identidad)
+    int columnaOrden = -1;
+    
+public:
+    ListaVirtual(wxWindow* parent)
+        : wxListCtrl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+                     wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL) {
+        Bind(wxEVT_LIST_COL_CLICK, &ListaVirtual::OnColumnClick, this);
+    }
+    
+    void Mostrar(std::vector<Columna> nuevas, size_t filas) {
+        ClearAll();
+        columnas = std::move(nuevas);
+        orden.clear();
+        columnaOrden = -1;
+        for (const auto& c : columnas) {
+            AppendColumn(c.titulo, c.formato, c.ancho);
+        }
+        SetItemCount(filas);
+        Refresh();
+    }
+    
+    // Repinta sólo las filas indicadas (índices de datos, no de pantalla)
+    void RefrescarFilas(const std::vector<size_t>& filas) {
+        if (filas.empty()) return;
+        if (orden.empty()) {
+            for (size_t f : filas) RefreshItem(f);
+            return;
+        }
+        std::vector<uint32_t> posicion(orden.size());
+        for (size_t i = 0; i < orden.size(); i++) posicion[orden[i]] = i;
+        for (size_t f : filas) RefreshItem(posicion[f]);
+    }
+    
+    void Limpiar() {
+        ClearAll();
+        SetItemCount(0);
+        columnas.clear();
+        orden.clear();
+        columnaOrden = -1;
+    }
+    
+protected:
+    wxString OnGetItemText(long item, long column) const override {
+        if (column < 0 || column >= (long)columnas.size()) return wxString();
+        size_t fila = orden.empty() ? (size_t)item : orden[item];
+        return columnas[column].texto(fila);
+    }
+    
+private:
+    void OnColumnClick(wxListEvent& event) {
+        int col = event.GetColumn();
+        if (col < 0 || col >= (int)columnas.size() || !columnas[col].menor) return;
+        
+        if (orden.empty()) {
+            orden.resize(GetItemCount());
+            std::iota(orden.begin(), orden.end(), 0u);
+        }
+        
+        if (col == columnaOrden) {
+            // Segundo clic en la misma columna: invertir el sentido
+            std::reverse(orden.begin(), orden.end());
+        } else {
+            const auto& menor = columnas[col].menor;
+            std::stable_sort(orden.begin(), orden.end(),
+                [&menor](uint32_t a, uint32_t b) { return menor(a, b); });
+            columnaOrden = col;
+        }
+        
+        if (GetItemCount() > 0) RefreshItems(0, GetItemCount() - 1);
+    }
+};
+
+// Columnas que leen un campo de un arreglo compartido
+template<typename T>
+ListaVirtual::Columna columnaTexto(const wxString& titulo, int formato, int ancho,
+                                   std::shared_ptr<const std::vector<T>> datos, std::string T::*campo) {
+    return {titulo, formato, ancho,
+        [datos, campo](size_t i) { return wxString((*datos)[i].*campo); },
+        [datos, campo](size_t a, size_t b) { return (*datos)[a].*campo < (*datos)[b].*campo; }};
+}
+
+template<typename T>
+ListaVirtual::Columna columnaEntera(const wxString& titulo, int formato, int ancho,
+                                    std::shared_ptr<const std::vector<T>> datos, int T::*campo) {
+    return {titulo, formato, ancho,
+        [datos, campo](size_t i) { return wxString::Format("%d", (*datos)[i].*campo); },
+        [datos, campo](size_t a, size_t b) { return (*datos)[a].*campo < (*datos)[b].*campo; }};
+}
+
 // Panel de métricas MULTI-ALGORITMO
 class MetricsPanel : public wxPanel {
 private:
@@ -314,36 +573,85 @@ public:
         SetSizer(mainSizer);
     }
     
-    void AddAlgorithmMetrics(const std::string& algorithmName, const SimulationResult& result, const std::vector<Proceso>& procesos) {
+    void AddAlgorithmMetrics(const std::string& algorithmName, const SimulationResult& result, ProcesosCompartidos procesos) {
+        // Tabla de métricas por proceso: lee el arreglo publicado, sin copiarlo
+        AddAlgorithmMetrics(algorithmName, result, {
+            columnaTexto("PID", wxLIST_FORMAT_LEFT, 100, procesos, &Proceso::pid),
+            columnaEntera("Tiempo de Espera", wxLIST_FORMAT_CENTER, 120, procesos, &Proceso::waiting_time),
+            columnaEntera("Tiempo de Retorno", wxLIST_FORMAT_CENTER, 120, procesos, &Proceso::turnaround_time),
+            columnaEntera("Tiempo de Completación", wxLIST_FORMAT_CENTER, 140, procesos, &Proceso::completion_time),
+            columnaEntera("Tiempo de Respuesta", wxLIST_FORMAT_CENTER, 130, procesos, &Proceso::response_time)
+        }, procesos->size());
+    }
+    
+    // Track de un archivo de resultados: las columnas se leen del archivo mapeado
+    void AddAlgorithmMetrics(std::shared_ptr<const ArchivoResultados> archivo, size_t track) {
+        auto texto = [archivo, track](size_t i) {
+            std::string_view pid = archivo->proceso(track, i).pid;
+            return wxString(pid.data(), pid.size());
+        };
+        auto entera = [archivo, track](const wxString& titulo, int ancho, int MetricasProceso::*campo) {
+            return ListaVirtual::Columna{titulo, wxLIST_FORMAT_CENTER, ancho,
+                [archivo, track, campo](size_t i) { return wxString::Format("%d", archivo->proceso(track, i).*campo); },
+                [archivo, track, campo](size_t a, size_t b) {
+                    return archivo->proceso(track, a).*campo < archivo->proceso(track, b).*campo; }};
+        };
+        AddAlgorithmMetrics(archivo->nombre(track), *archivo->resultado(track), {
+            {"PID", wxLIST_FORMAT_LEFT, 100, texto, [archivo, track](size_t a, size_t b) {
+                return archivo->proceso(track, a).pid < archivo->proceso(track, b).pid; }},
+            entera("Tiempo de Espera", 120, &MetricasProceso::waiting_time),
+            entera("Tiempo de Retorno", 120, &MetricasProceso::turnaround_time),
+            entera("Tiempo de Completación", 140, &MetricasProceso::completion_time),
+            entera("Tiempo de Respuesta", 130, &MetricasProceso::response_time)
+        }, archivo->procesos(track));
+    }
+    
+    void AddAlgorithmMetrics(const std::string& algorithmName, const SimulationResult& result,
+                             std::vector<ListaVirtual::Columna> columnasProceso, size_t filas) {
         wxPanel* panel = new wxPanel(algorithmNotebook);
         wxBoxSizer* panelSizer = new wxBoxSizer(wxVERTICAL);
         
         // Métricas generales
-        wxStaticText* avgWaitingLabel = new wxStaticText(panel, wxID_ANY, 
-            wxString::Format("Waiting Time Promedio: %.2f", result.avgWaitingTime));
-        wxStaticText* avgTurnaroundLabel = new wxStaticText(panel, wxID_ANY, 
-            wxString::Format("TurnAround Promedio: %.2f", result.avgTurnaroundTime));
+        wxString generales[] = {
+            wxString::Format("Waiting Time Promedio: %.2f", result.avgWaitingTime),
+            wxString::Format("TurnAround Promedio: %.2f", result.avgTurnaroundTime),
+            wxString::Format("Response Time Promedio: %.2f", result.avgResponseTime),
+            wxString::Format("Cambios de Contexto: %d", result.contextSwitches),
+            wxString::Format("Utilizacion de CPU: %.1f%%", result.cpuUtilization * 100),
+            wxString::Format("Throughput: %.3f procesos/ciclo", result.throughput),
+            wxString::Format("Makespan: %d ciclos", result.makespan)
+        };
+        
+        for (const auto& texto : generales) {
+            wxStaticText* label = new wxStaticText(panel, wxID_ANY, texto);
+            label->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
+            panelSizer->Add(label, 0, wxALL, 5);
+        }
         
-        avgWaitingLabel->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
-        avgTurnaroundLabel->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
+        // La utilización de cada dispositivo se reporta aparte de la del CPU
+        for (size_t d = 0; d < result.utilizacionES.size(); d++) {
+            panelSizer->Add(new wxStaticText(panel, wxID_ANY,
+                wxString::Format("Utilizacion del dispositivo D%zu: %.1f%%", d, result.utilizacionES[d] * 100)),
+                0, wxALL, 5);
+        }
         
-        panelSizer->Add(avgWaitingLabel, 0, wxALL, 5);
-        panelSizer->Add(avgTurnaroundLabel, 0, wxALL, 5);
+        // Percentiles de cola
+        std::pair<const char*, const SketchCuantiles*> distribuciones[] = {
+            {"Espera", &result.waiting},
+            {"Retorno", &result.turnaround},
+            {"Respuesta", &result.response}
+        };
+        
+        for (const auto& [nombre, sketch] : distribuciones) {
+            panelSizer->Add(new wxStaticText(panel, wxID_ANY,
+                wxString::Format("%s p50/p95/p99/max: %.1f / %.1f / %.1f / %d", nombre,
+                    sketch->cuantil(0.50), sketch->cuantil(0.95), sketch->cuantil(0.99), sketch->maximo())),
+                0, wxALL, 5);
+        }
         panelSizer->Add(new wxStaticLine(panel), 0, wxEXPAND | wxALL, 10);
         
-        // Tabla de métricas por proceso
-        wxListCtrl* processMetrics = new wxListCtrl(panel, wxID_ANY, wxDefaultPosition, wxDefaultSize,
-                                                    wxLC_REPORT | wxLC_SINGLE_SEL);
-        processMetrics->AppendColumn("PID", wxLIST_FORMAT_LEFT, 100);
-        processMetrics->AppendColumn("Tiempo de Espera", wxLIST_FORMAT_CENTER, 120);
-        processMetrics->AppendColumn("Tiempo de Retorno", wxLIST_FORMAT_CENTER, 120);
-        processMetrics->AppendColumn("Tiempo de Completación", wxLIST_FORMAT_CENTER, 140);
-        
-        for (size_t i = 0; i < procesos.size(); i++) {
-            long index = processMetrics->InsertItem(i, procesos[i].pid);
-            processMetrics->SetItem(index, 1, wxString::Format("%d", procesos[i].waiting_time));
-            processMetrics->SetItem(index, 2, wxString::Format("%d", procesos[i].turnaround_time));
-        }
+        ListaVirtual* processMetrics = new ListaVirtual(panel);
+        processMetrics->Mostrar(std::move(columnasProceso), filas);
         
         panelSizer->Add(processMetrics, 1, wxEXPAND | wxALL, 5);
         
@@ -358,80 +666,401 @@ public:
     }
 };
 
-// Panel de lista de información (sin cambios)
+// Panel de lista de información
 class InfoListPanel : public wxPanel {
 private:
-    wxListCtrl* listCtrl;
+    ListaVirtual* listCtrl;
+    std::shared_ptr<const std::vector<Recurso>> recursosMostrados;
     
 public:
     InfoListPanel(wxWindow* parent) : wxPanel(parent) {
         wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
         
-        listCtrl = new wxListCtrl(this, wxID_ANY, wxDefaultPosition, wxDefaultSize,
-                                   wxLC_REPORT | wxLC_SINGLE_SEL);
+        listCtrl = new ListaVirtual(this);
         sizer->Add(listCtrl, 1, wxEXPAND | wxALL, 5);
         
         SetSizer(sizer);
     }
     
     void ShowProcesses(const std::vector<Proceso>& procesos) {
-        listCtrl->ClearAll();
-        listCtrl->AppendColumn("PID", wxLIST_FORMAT_LEFT, 100);
-        listCtrl->AppendColumn("Burst Time", wxLIST_FORMAT_CENTER, 100);
-        listCtrl->AppendColumn("Arrival Time", wxLIST_FORMAT_CENTER, 100);
-        listCtrl->AppendColumn("Priority", wxLIST_FORMAT_CENTER, 100);
-        
-        for (size_t i = 0; i < procesos.size(); i++) {
-            long index = listCtrl->InsertItem(i, procesos[i].pid);
-            listCtrl->SetItem(index, 1, wxString::Format("%d", procesos[i].burst_time));
-            listCtrl->SetItem(index, 2, wxString::Format("%d", procesos[i].arrival_time));
-            listCtrl->SetItem(index, 3, wxString::Format("%d", procesos[i].priority));
-        }
+        recursosMostrados.reset();
+        auto datos = std::make_shared<const std::vector<Proceso>>(procesos);
+        listCtrl->Mostrar({
+            columnaTexto("PID", wxLIST_FORMAT_LEFT, 100, datos, &Proceso::pid),
+            columnaEntera("Burst Time", wxLIST_FORMAT_CENTER, 100, datos, &Proceso::burst_time),
+            columnaEntera("Arrival Time", wxLIST_FORMAT_CENTER, 100, datos, &Proceso::arrival_time),
+            columnaEntera("Priority", wxLIST_FORMAT_CENTER, 100, datos, &Proceso::priority),
+            {"Rafagas E/S", wxLIST_FORMAT_CENTER, 100,
+                [datos](size_t i) { return wxString::Format("%zu", (*datos)[i].es.size()); },
+                [datos](size_t a, size_t b) { return (*datos)[a].es.size() < (*datos)[b].es.size(); }}
+        }, datos->size());
     }
     
     void ShowResources(const std::map<std::string, Recurso>& recursos) {
-        listCtrl->ClearAll();
-        listCtrl->AppendColumn("Nombre", wxLIST_FORMAT_LEFT, 150);
-        listCtrl->AppendColumn("Contador Inicial", wxLIST_FORMAT_CENTER, 120);
-        listCtrl->AppendColumn("Contador Actual", wxLIST_FORMAT_CENTER, 120);
-        listCtrl->AppendColumn("Estado", wxLIST_FORMAT_CENTER, 100);
-        
-        int i = 0;
-        for (const auto& [nombre, recurso] : recursos) {
-            long index = listCtrl->InsertItem(i++, nombre);
-            listCtrl->SetItem(index, 1, wxString::Format("%d", recurso.contador_inicial));
-            listCtrl->SetItem(index, 2, wxString::Format("%d", recurso.contador));
-            
-            std::string estado;
-            if (recurso.ocupado) {
-                estado = "Ocupado por " + recurso.proceso_actual;
-            } else if (recurso.contador < recurso.contador_inicial) {
-                estado = wxString::Format("En uso (%d/%d)", 
-                    recurso.contador_inicial - recurso.contador, recurso.contador_inicial).ToStdString();
-            } else {
-                estado = "Disponible";
+        auto datos = std::make_shared<std::vector<Recurso>>();
+        datos->reserve(recursos.size());
+        for (const auto& [nombre, recurso] : recursos) datos->push_back(recurso);
+        ShowResources(std::move(datos));
+    }
+    
+    void ShowResources(std::shared_ptr<const std::vector<Recurso>> recursos) {
+        recursosMostrados = std::move(recursos);
+        
+        // Las columnas leen la instantánea vigente, así UpdateResources puede
+        // reemplazarla sin reconstruir la tabla
+        auto recurso = [this](size_t i) -> const Recurso& { return (*recursosMostrados)[i]; };
+        auto estado = [recurso](size_t i) -> wxString {
+            const Recurso& r = recurso(i);
+            if (r.ocupado) {
+                return "Ocupado por " + r.proceso_actual;
+            } else if (r.contador_inicial == r.contador && !r.procesos_uso.empty()) {
+                return wxString::Format("Leyendo (%zu)", r.procesos_uso.size());
+            } else if (r.contador < r.contador_inicial) {
+                return wxString::Format("En uso (%d/%d)",
+                    r.contador_inicial - r.contador, r.contador_inicial);
             }
-            listCtrl->SetItem(index, 3, estado);
-        }
+            return "Disponible";
+        };
+        
+        listCtrl->Mostrar({
+            {"Nombre", wxLIST_FORMAT_LEFT, 150,
+                [recurso](size_t i) { return wxString(recurso(i).nombre); },
+                [recurso](size_t a, size_t b) { return recurso(a).nombre < recurso(b).nombre; }},
+            {"Contador Inicial", wxLIST_FORMAT_CENTER, 120,
+                [recurso](size_t i) { return wxString::Format("%d", recurso(i).contador_inicial); },
+                [recurso](size_t a, size_t b) { return recurso(a).contador_inicial < recurso(b).contador_inicial; }},
+            {"Contador Actual", wxLIST_FORMAT_CENTER, 120,
+                [recurso](size_t i) { return wxString::Format("%d", recurso(i).contador); },
+                [recurso](size_t a, size_t b) { return recurso(a).contador < recurso(b).contador; }},
+            {"Estado", wxLIST_FORMAT_CENTER, 100, estado, nullptr}
+        }, recursosMostrados->size());
     }
     
-    void ShowActions(const std::vector<Accion>& acciones) {
-        listCtrl->ClearAll();
-        listCtrl->AppendColumn("PID", wxLIST_FORMAT_LEFT, 100);
-        listCtrl->AppendColumn("Tipo", wxLIST_FORMAT_CENTER, 100);
-        listCtrl->AppendColumn("Recurso", wxLIST_FORMAT_CENTER, 100);
-        listCtrl->AppendColumn("Ciclo", wxLIST_FORMAT_CENTER, 100);
+    // Cambia a una instantánea nueva y repinta sólo las filas que difieren
+    void UpdateResources(std::shared_ptr<const std::vector<Recurso>> recursos) {
+        if (!recursosMostrados || recursos->size() != recursosMostrados->size()) {
+            ShowResources(std::move(recursos));
+            return;
+        }
         
-        for (size_t i = 0; i < acciones.size(); i++) {
-            long index = listCtrl->InsertItem(i, acciones[i].pid);
-            listCtrl->SetItem(index, 1, acciones[i].tipo);
-            listCtrl->SetItem(index, 2, acciones[i].recurso);
-            listCtrl->SetItem(index, 3, wxString::Format("%d", acciones[i].ciclo));
+        std::vector<size_t> cambiadas;
+        for (size_t i = 0; i < recursos->size(); i++) {
+            const Recurso& antes = (*recursosMostrados)[i];
+            const Recurso& ahora = (*recursos)[i];
+            if (antes.nombre != ahora.nombre || antes.contador != ahora.contador ||
+                antes.contador_inicial != ahora.contador_inicial ||
+                antes.ocupado != ahora.ocupado || antes.proceso_actual != ahora.proceso_actual ||
+                antes.procesos_uso.size() != ahora.procesos_uso.size()) {
+                cambiadas.push_back(i);
+            }
         }
+        
+        recursosMostrados = std::move(recursos);
+        listCtrl->RefrescarFilas(cambiadas);
+    }
+    
+    void ShowActions(const std::vector<Accion>& acciones) {
+        recursosMostrados.reset();
+        auto datos = std::make_shared<const std::vector<Accion>>(acciones);
+        listCtrl->Mostrar({
+            columnaTexto("PID", wxLIST_FORMAT_LEFT, 100, datos, &Accion::pid),
+            columnaTexto("Tipo", wxLIST_FORMAT_CENTER, 100, datos, &Accion::tipo),
+            columnaTexto("Recurso", wxLIST_FORMAT_CENTER, 100, datos, &Accion::recurso),
+            columnaEntera("Ciclo", wxLIST_FORMAT_CENTER, 100, datos, &Accion::ciclo)
+        }, datos->size());
     }
     
     void Clear() {
-        listCtrl->ClearAll();
+        recursosMostrados.reset();
+        listCtrl->Limpiar();
+    }
+};
+
+// Parámetros de la distribución de cargas para el modo Monte Carlo
+class MonteCarloDialog : public wxDialog {
+private:
+    wxSpinCtrl* replicasSpinner;
+    wxSpinCtrl* processesSpinner;
+    wxSpinCtrlDouble* arrivalRateSpinner;
+    wxChoice* burstChoice;
+    wxSpinCtrl* burstMinSpinner;
+    wxSpinCtrl* burstMaxSpinner;
+    wxSpinCtrlDouble* burstMeanSpinner;
+    wxTextCtrl* priorityWeightsText;
+    wxSpinCtrl* ioPercentSpinner;
+    wxSpinCtrl* ioDevicesSpinner;
+    wxSpinCtrl* seedSpinner;
+    
+public:
+    MonteCarloDialog(wxWindow* parent) : wxDialog(parent, wxID_ANY, "Monte Carlo") {
+        wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+        wxFlexGridSizer* grid = new wxFlexGridSizer(2, 5, 10);
+        
+        auto addRow = [&](const wxString& label, wxWindow* control) {
+            grid->Add(new wxStaticText(this, wxID_ANY, label), 0, wxALIGN_CENTER_VERTICAL);
+            grid->Add(control, 0, wxEXPAND);
+        };
+        
+        replicasSpinner = new wxSpinCtrl(this, wxID_ANY, "200", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 2, 100000, 200);
+        processesSpinner = new wxSpinCtrl(this, wxID_ANY, "100", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 1000000, 100);
+        arrivalRateSpinner = new wxSpinCtrlDouble(this, wxID_ANY, "0.1", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0.001, 100, 0.1, 0.01);
+        
+        wxArrayString bursts;
+        bursts.Add("Uniforme");
+        bursts.Add("Exponencial");
+        bursts.Add("Bimodal");
+        burstChoice = new wxChoice(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, bursts);
+        burstChoice->SetSelection(0);
+        
+        burstMinSpinner = new wxSpinCtrl(this, wxID_ANY, "1", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 100000, 1);
+        burstMaxSpinner = new wxSpinCtrl(this, wxID_ANY, "20", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 100000, 20);
+        burstMeanSpinner = new wxSpinCtrlDouble(this, wxID_ANY, "8", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 100000, 8, 0.5);
+        priorityWeightsText = new wxTextCtrl(this, wxID_ANY, "1,1,1,1,1");
+        ioPercentSpinner = new wxSpinCtrl(this, wxID_ANY, "0", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0, 100, 0);
+        ioDevicesSpinner = new wxSpinCtrl(this, wxID_ANY, "1", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 1, 16, 1);
+        seedSpinner = new wxSpinCtrl(this, wxID_ANY, "1", wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, 0, INT_MAX, 1);
+        
+        addRow("Replicas:", replicasSpinner);
+        addRow("Procesos por carga:", processesSpinner);
+        addRow("Llegadas por ciclo:", arrivalRateSpinner);
+        addRow("Distribucion de rafagas:", burstChoice);
+        addRow("Rafaga minima:", burstMinSpinner);
+        addRow("Rafaga maxima:", burstMaxSpinner);
+        addRow("Rafaga media:", burstMeanSpinner);
+        addRow("Pesos de prioridad 1..n:", priorityWeightsText);
+        addRow("% procesos con E/S:", ioPercentSpinner);
+        addRow("Dispositivos de E/S:", ioDevicesSpinner);
+        addRow("Semilla:", seedSpinner);
+        
+        mainSizer->Add(grid, 1, wxEXPAND | wxALL, 10);
+        mainSizer->Add(CreateStdDialogButtonSizer(wxOK | wxCANCEL), 0, wxEXPAND | wxALL, 10);
+        SetSizerAndFit(mainSizer);
+    }
+    
+    ParametrosMonteCarlo GetParametros() const {
+        ParametrosMonteCarlo parametros;
+        DistribucionCarga& d = parametros.distribucion;
+        d.procesos = processesSpinner->GetValue();
+        d.tasaLlegada = arrivalRateSpinner->GetValue();
+        d.rafaga = static_cast<DistribucionCarga::Rafaga>(burstChoice->GetSelection());
+        d.rafagaMin = burstMinSpinner->GetValue();
+        d.rafagaMax = burstMaxSpinner->GetValue();
+        d.rafagaMedia = burstMeanSpinner->GetValue();
+        d.fraccionES = ioPercentSpinner->GetValue() / 100.0;
+        d.dispositivosES = ioDevicesSpinner->GetValue();
+        
+        d.pesosPrioridad.clear();
+        std::stringstream ss(priorityWeightsText->GetValue().ToStdString());
+        std::string peso;
+        while (std::getline(ss, peso, ',')) {
+            double valor = std::atof(peso.c_str());
+            d.pesosPrioridad.push_back(std::max(0.0, valor));
+        }
+        
+        parametros.replicas = replicasSpinner->GetValue();
+        parametros.semilla = seedSpinner->GetValue();
+        return parametros;
+    }
+};
+
+// Medias e intervalos de confianza del 95% de cada métrica por algoritmo
+class MonteCarloResultDialog : public wxDialog {
+public:
+    MonteCarloResultDialog(wxWindow* parent, const std::vector<ResumenMonteCarlo>& resumen,
+                           const std::vector<std::string>& algorithmNames)
+        : wxDialog(parent, wxID_ANY, "Resultados Monte Carlo", wxDefaultPosition, wxSize(650, 500),
+                   wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER) {
+        wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+        
+        if (!resumen.empty()) {
+            mainSizer->Add(new wxStaticText(this, wxID_ANY,
+                wxString::Format("%d replicas por algoritmo, intervalos de confianza del 95%%", resumen[0].replicas)),
+                0, wxALL, 10);
+        }
+        
+        wxListCtrl* list = new wxListCtrl(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxLC_REPORT | wxLC_SINGLE_SEL);
+        list->AppendColumn("Algoritmo", wxLIST_FORMAT_LEFT, 110);
+        list->AppendColumn("Metrica", wxLIST_FORMAT_LEFT, 170);
+        list->AppendColumn("Media", wxLIST_FORMAT_CENTER, 100);
+        list->AppendColumn("IC 95%", wxLIST_FORMAT_CENTER, 190);
+        
+        long row = 0;
+        for (const auto& r : resumen) {
+            for (int m = 0; m < MC_NUM_METRICAS; m++) {
+                const Intervalo& ic = r.metricas[m];
+                long index = list->InsertItem(row++, algorithmNames[static_cast<int>(r.algoritmo)]);
+                list->SetItem(index, 1, NOMBRES_METRICAS_MC[m]);
+                list->SetItem(index, 2, wxString::Format("%.3f", ic.media));
+                list->SetItem(index, 3, wxString::Format("[%.3f, %.3f]", ic.media - ic.mitad, ic.media + ic.mitad));
+            }
+        }
+        
+        mainSizer->Add(list, 1, wxEXPAND | wxALL, 5);
+        mainSizer->Add(CreateStdDialogButtonSizer(wxOK), 0, wxEXPAND | wxALL, 10);
+        SetSizer(mainSizer);
+    }
+};
+
+// Mediciones de la réplica con hilos reales junto a la predicción del modelo
+class ContencionRealDialog : public wxDialog {
+public:
+    ContencionRealDialog(wxWindow* parent, const std::vector<Accion>& acciones, ResultadoContencion resultado,
+                         const OpcionesContencion& opciones)
+        : wxDialog(parent, wxID_ANY, "Contencion con hilos reales", wxDefaultPosition, wxSize(820, 560),
+                   wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER) {
+        wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+        
+        const ResultadoContencion& r = resultado;
+        int total = acciones.size();
+        wxString resumen;
+        resumen += wxString::Format("%s reales, %d hilos, 1 ciclo = %d us%s\n",
+                                    opciones.mutex ? "std::mutex" : "Semaforos", r.hilos, opciones.usPorCiclo,
+                                    r.cancelado ? " (cancelado)" : "");
+        resumen += wxString::Format("Latencia de adquisicion (us): p50 %.1f, p95 %.1f, p99 %.1f, max %.1f\n",
+                                    r.latenciaNs.cuantil(0.50) / 1000, r.latenciaNs.cuantil(0.95) / 1000,
+                                    r.latenciaNs.cuantil(0.99) / 1000, r.latenciaNs.maximo() / 1000.0);
+        resumen += wxString::Format("Retencion media: %.1f us (modelo: %d us)\n", r.retencionMediaUs,
+                                    opciones.usPorCiclo * opciones.ciclosRetencion);
+        resumen += wxString::Format("Adquisiciones por segundo: %.1f reales, %.1f segun el modelo\n",
+                                    r.adquisicionesPorSegundo, r.adquisicionesPorSegundoModelo);
+        resumen += wxString::Format("Esperas: %d predichas (WAITING), %d reales; coinciden %d de %d acciones (%.1f%%)",
+                                    r.esperasPredichas, r.esperasReales, r.coincidencias, total,
+                                    total ? 100.0 * r.coincidencias / total : 0.0);
+        mainSizer->Add(new wxStaticText(this, wxID_ANY, resumen), 0, wxALL, 10);
+        
+        auto datos = std::make_shared<const std::vector<Accion>>(acciones);
+        auto medidas = std::make_shared<const std::vector<MedicionAccion>>(std::move(resultado.mediciones));
+        auto porMedida = [medidas](auto campo) {
+            return [medidas, campo](size_t a, size_t b) { return (*medidas)[a].*campo < (*medidas)[b].*campo; };
+        };
+        ListaVirtual* list = new ListaVirtual(this);
+        list->Mostrar({
+            columnaTexto("PID", wxLIST_FORMAT_LEFT, 80, datos, &Accion::pid),
+            columnaTexto("Tipo", wxLIST_FORMAT_CENTER, 80, datos, &Accion::tipo),
+            columnaTexto("Recurso", wxLIST_FORMAT_CENTER, 80, datos, &Accion::recurso),
+            columnaEntera("Ciclo", wxLIST_FORMAT_CENTER, 60, datos, &Accion::ciclo),
+            {"Modelo", wxLIST_FORMAT_CENTER, 100,
+                [medidas](size_t i) { return wxString((*medidas)[i].esperaPredicha ? "WAITING" : "ACCESSED"); },
+                porMedida(&MedicionAccion::esperaPredicha)},
+            {"Real", wxLIST_FORMAT_CENTER, 100,
+                [medidas](size_t i) { return wxString((*medidas)[i].espero ? "Espero" : "Inmediato"); },
+                porMedida(&MedicionAccion::espero)},
+            {"Latencia (us)", wxLIST_FORMAT_RIGHT, 110,
+                [medidas](size_t i) { return wxString::Format("%.1f", (*medidas)[i].latenciaNs / 1000.0); },
+                porMedida(&MedicionAccion::latenciaNs)},
+            {"Retencion (us)", wxLIST_FORMAT_RIGHT, 110,
+                [medidas](size_t i) { return wxString::Format("%.1f", (*medidas)[i].retencionNs / 1000.0); },
+                porMedida(&MedicionAccion::retencionNs)}
+        }, datos->size());
+        
+        mainSizer->Add(list, 1, wxEXPAND | wxALL, 5);
+        mainSizer->Add(CreateStdDialogButtonSizer(wxOK), 0, wxEXPAND | wxALL, 10);
+        SetSizer(mainSizer);
+    }
+};
+
+// Lectores/escritores: las tres políticas sobre las mismas acciones
+class LectoresEscritoresDialog : public wxDialog {
+public:
+    LectoresEscritoresDialog(wxWindow* parent, const std::vector<MetricasRW>& metricas, int ciclosRetencion)
+        : wxDialog(parent, wxID_ANY, "Politicas de lectores/escritores", wxDefaultPosition, wxSize(900, 300),
+                   wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER) {
+        wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+        mainSizer->Add(new wxStaticText(this, wxID_ANY,
+            wxString::Format("Cada acceso retiene el recurso %d ciclos; esperas en ciclos", ciclosRetencion)),
+            0, wxALL, 10);
+        
+        wxListCtrl* list = new wxListCtrl(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxLC_REPORT | wxLC_SINGLE_SEL);
+        list->AppendColumn("Politica", wxLIST_FORMAT_LEFT, 140);
+        list->AppendColumn("Lectores simultaneos", wxLIST_FORMAT_CENTER, 140);
+        list->AppendColumn("Espera escritores", wxLIST_FORMAT_CENTER, 180);
+        list->AppendColumn("Espera lectores", wxLIST_FORMAT_CENTER, 180);
+        list->AppendColumn("Acciones/ciclo", wxLIST_FORMAT_CENTER, 110);
+        list->AppendColumn("Makespan", wxLIST_FORMAT_CENTER, 90);
+        
+        auto espera = [](const SketchCuantiles& s) {
+            return wxString::Format("prom %.2f, p95 %.0f, max %d", s.promedio(), s.cuantil(0.95), s.maximo());
+        };
+        long row = 0;
+        for (const auto& m : metricas) {
+            long index = list->InsertItem(row++, NOMBRES_POLITICA_RW[static_cast<int>(m.politica)]);
+            list->SetItem(index, 1, wxString::Format("prom %.2f, max %d", m.lectoresPromedio, m.lectoresMaximo));
+            list->SetItem(index, 2, espera(m.esperaEscritores));
+            list->SetItem(index, 3, espera(m.esperaLectores));
+            list->SetItem(index, 4, wxString::Format("%.3f", m.throughput));
+            list->SetItem(index, 5, wxString::Format("%d", m.makespan));
+        }
+        
+        mainSizer->Add(list, 1, wxEXPAND | wxALL, 5);
+        mainSizer->Add(CreateStdDialogButtonSizer(wxOK), 0, wxEXPAND | wxALL, 10);
+        SetSizer(mainSizer);
+    }
+};
+
+// Prioridad + recursos: cuánto estuvo bloqueado cada proceso con cada protocolo
+class InversionPrioridadDialog : public wxDialog {
+public:
+    InversionPrioridadDialog(wxWindow* parent, std::vector<ResultadoInversion> resultados)
+        : wxDialog(parent, wxID_ANY, "Inversion de prioridad", wxDefaultPosition, wxSize(860, 520),
+                   wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER) {
+        wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+        
+        wxString resumen;
+        for (const auto& r : resultados) {
+            resumen += wxString::Format("%s: %zu inversiones (%d ciclos), bloqueo p50 %.0f / p99 %.0f / max %d, makespan %d%s\n",
+                                        NOMBRES_PROTOCOLO[static_cast<int>(r.protocolo)], r.inversiones.size(),
+                                        r.ciclosInversion, r.bloqueo.cuantil(0.50), r.bloqueo.cuantil(0.99),
+                                        r.bloqueo.maximo(), r.makespan, r.interbloqueo ? " (interbloqueo)" : "");
+        }
+        mainSizer->Add(new wxStaticText(this, wxID_ANY, resumen), 0, wxALL, 10);
+        
+        // Una fila por protocolo y proceso sobre los vectores de resultados,
+        // sin copiar celdas al control. Todos los protocolos corren la misma
+        // carga, así que comparten el orden: los de mayor prioridad primero,
+        // que son los que sufren la inversión.
+        auto datos = std::make_shared<const std::vector<ResultadoInversion>>(std::move(resultados));
+        size_t porProtocolo = datos->empty() ? 0 : datos->front().procesos.size();
+        auto orden = std::make_shared<std::vector<uint32_t>>(porProtocolo);
+        std::iota(orden->begin(), orden->end(), 0u);
+        if (porProtocolo > 0) {
+            const auto& procesos = datos->front().procesos;
+            std::stable_sort(orden->begin(), orden->end(), [&procesos](uint32_t a, uint32_t b) {
+                return procesos[a].prioridad < procesos[b].prioridad;
+            });
+        }
+        auto fila = [datos, orden, porProtocolo](size_t i) -> const BloqueoProceso& {
+            return (*datos)[i / porProtocolo].procesos[(*orden)[i % porProtocolo]];
+        };
+        auto entero = [fila](const wxString& titulo, int ancho, int BloqueoProceso::*campo) {
+            return ListaVirtual::Columna{titulo, wxLIST_FORMAT_CENTER, ancho,
+                [fila, campo](size_t i) { return wxString::Format("%d", fila(i).*campo); },
+                [fila, campo](size_t a, size_t b) { return fila(a).*campo < fila(b).*campo; }};
+        };
+        ListaVirtual* list = new ListaVirtual(this);
+        list->Mostrar({
+            {"Protocolo", wxLIST_FORMAT_LEFT, 150,
+                [datos, porProtocolo](size_t i) {
+                    return wxString(NOMBRES_PROTOCOLO[static_cast<int>((*datos)[i / porProtocolo].protocolo)]);
+                },
+                [porProtocolo](size_t a, size_t b) { return a / porProtocolo < b / porProtocolo; }},
+            {"PID", wxLIST_FORMAT_LEFT, 70,
+                [fila](size_t i) { return wxString(fila(i).pid); },
+                [fila](size_t a, size_t b) { return fila(a).pid < fila(b).pid; }},
+            entero("Prioridad", 70, &BloqueoProceso::prioridad),
+            entero("Bloqueos", 70, &BloqueoProceso::bloqueos),
+            entero("Ciclos bloqueado", 110, &BloqueoProceso::ciclosBloqueado),
+            entero("Max bloqueo", 90, &BloqueoProceso::maxBloqueo),
+            entero("Ciclos en inversion", 120, &BloqueoProceso::ciclosInversion),
+            {"Completion", wxLIST_FORMAT_CENTER, 90,
+                [fila](size_t i) {
+                    return fila(i).completion >= 0 ? wxString::Format("%d", fila(i).completion) : wxString("-");
+                },
+                [fila](size_t a, size_t b) { return fila(a).completion < fila(b).completion; }}
+        }, datos->size() * porProtocolo);
+        
+        mainSizer->Add(list, 1, wxEXPAND | wxALL, 5);
+        mainSizer->Add(CreateStdDialogButtonSizer(wxOK), 0, wxEXPAND | wxALL, 10);
+        SetSizer(mainSizer);
     }
 };
 
@@ -440,19 +1069,61 @@ class SchedulingPanel : public wxPanel {
 private:
     wxChoice* algorithmChoice;
     wxSpinCtrl* quantumSpinner;
+    wxSpinCtrl* contextSwitchSpinner;
+    wxCheckBox* traceCheck;
     wxButton* loadButton;
     wxButton* runButton;
     wxButton* clearButton;
+    wxButton* monteCarloButton;
+    wxButton* exportButton;
+    wxButton* saveResultsButton;
+    wxButton* openResultsButton;
     wxCheckListBox* algorithmList;
     GanttPanel* ganttPanel;
     InfoListPanel* infoPanel;
     MetricsPanel* metricsPanel;
     
+    wxButton* pauseButton;
+    wxButton* stepButton;
+    wxSpinCtrl* speedSpinner;
+    wxTimer simulationTimer;
+    
+    wxSpinCtrl* checkpointSpinner;
+    wxSpinCtrl* checkpointMemSpinner;
+    wxSlider* scrubSlider;
+    wxStaticText* scrubLabel;
+    
     std::vector<Proceso> procesos;
-    std::thread* simulationThread = nullptr;
-    std::atomic<bool> stopSimulation{false};
+    std::shared_ptr<const ArchivoResultados> resultadosAbiertos; // Último archivo de resultados abierto
+    
+    // Estado de la corrida: el timer de la GUI avanza el motor ciclo a ciclo
+    std::unique_ptr<MotorCalendarizacion> motor;
+    std::vector<int> pendingAlgorithms;
+    int currentAlgorithm = -1;
+    SimulationConfig runConfig;
+    std::shared_ptr<TrazaSimulacion> traza;
+    bool paused = false;
     
-    std::vector<std::string> algorithmNames = {"FIFO", "SJF", "SRT", "Round Robin", "Priority"};
+    // Velocidad 0: tiempo de simulación por tick del timer y ciclos entre
+    // consultas al reloj (un ciclo cuesta de décimas a cientos de µs)
+    static constexpr std::chrono::milliseconds PRESUPUESTO_POR_TICK{10};
+    static constexpr int CICLOS_ENTRE_RELOJ = 16;
+    
+    // Checkpoints de la corrida actual y, por algoritmo terminado, su historial.
+    // El reproductor se crea la primera vez que se usa el scrubber.
+    struct Reproduccion {
+        int algorithm;
+        int quantum;
+        std::shared_ptr<const HistorialCheckpoints> historial;
+        std::unique_ptr<ReproductorCheckpoints> reproductor;
+    };
+    std::shared_ptr<HistorialCheckpoints> historial;
+    std::vector<Reproduccion> reproducciones;
+    
+    std::vector<std::string> algorithmNames = {"FIFO", "SJF", "SRT", "Round Robin", "Priority", "Lottery", "Stride"};
+    
+    // Hilos de las réplicas Monte Carlo
+    EjecutorTrabajos ejecutor;
     
 public:
     SchedulingPanel(wxWindow* parent) : wxPanel(parent) {
@@ -478,17 +1149,71 @@ public:
         quantumSpinner = new wxSpinCtrl(controlPanel, wxID_ANY, "2", wxDefaultPosition, wxSize(80, -1), wxSP_ARROW_KEYS, 1, 10, 2);
         controlSizer->Add(quantumSpinner, 0, wxALL, 5);
         
+        wxStaticText* contextSwitchLabel = new wxStaticText(controlPanel, wxID_ANY, "Cambio de contexto:");
+        controlSizer->Add(contextSwitchLabel, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        contextSwitchSpinner = new wxSpinCtrl(controlPanel, wxID_ANY, "0", wxDefaultPosition, wxSize(80, -1), wxSP_ARROW_KEYS, 0, 10, 0);
+        controlSizer->Add(contextSwitchSpinner, 0, wxALL, 5);
+        
+        traceCheck = new wxCheckBox(controlPanel, wxID_ANY, "Exportar traza");
+        controlSizer->Add(traceCheck, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        wxStaticText* speedLabel = new wxStaticText(controlPanel, wxID_ANY, "ms/ciclo:");
+        controlSizer->Add(speedLabel, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        // 0 = sin animación, el motor corre a toda velocidad
+        speedSpinner = new wxSpinCtrl(controlPanel, wxID_ANY, "300", wxDefaultPosition, wxSize(80, -1), wxSP_ARROW_KEYS, 0, 2000, 300);
+        controlSizer->Add(speedSpinner, 0, wxALL, 5);
+        
         loadButton = new wxButton(controlPanel, wxID_ANY, "Cargar Procesos");
         runButton = new wxButton(controlPanel, wxID_ANY, "Ejecutar Simulacion");
+        pauseButton = new wxButton(controlPanel, wxID_ANY, "Pausar");
+        stepButton = new wxButton(controlPanel, wxID_ANY, "Paso");
         clearButton = new wxButton(controlPanel, wxID_ANY, "Limpiar");
+        monteCarloButton = new wxButton(controlPanel, wxID_ANY, "Monte Carlo");
+        exportButton = new wxButton(controlPanel, wxID_ANY, "Exportar Gantt");
+        saveResultsButton = new wxButton(controlPanel, wxID_ANY, "Guardar Resultados");
+        openResultsButton = new wxButton(controlPanel, wxID_ANY, "Abrir Resultados");
+        
+        pauseButton->Enable(false);
+        stepButton->Enable(false);
         
         controlSizer->Add(loadButton, 0, wxALL, 5);
         controlSizer->Add(runButton, 0, wxALL, 5);
+        controlSizer->Add(pauseButton, 0, wxALL, 5);
+        controlSizer->Add(stepButton, 0, wxALL, 5);
         controlSizer->Add(clearButton, 0, wxALL, 5);
+        controlSizer->Add(monteCarloButton, 0, wxALL, 5);
+        controlSizer->Add(exportButton, 0, wxALL, 5);
+        controlSizer->Add(saveResultsButton, 0, wxALL, 5);
+        controlSizer->Add(openResultsButton, 0, wxALL, 5);
         
         controlPanel->SetSizer(controlSizer);
         mainSizer->Add(controlPanel, 0, wxEXPAND | wxALL, 5);
         
+        // Scrubber: reconstruye el estado de cualquier ciclo desde los checkpoints
+        wxPanel* scrubPanel = new wxPanel(this);
+        wxBoxSizer* scrubSizer = new wxBoxSizer(wxHORIZONTAL);
+        
+        scrubSizer->Add(new wxStaticText(scrubPanel, wxID_ANY, "Checkpoint cada:"), 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        checkpointSpinner = new wxSpinCtrl(scrubPanel, wxID_ANY, "1000", wxDefaultPosition, wxSize(90, -1), wxSP_ARROW_KEYS, 1, 1000000, 1000);
+        scrubSizer->Add(checkpointSpinner, 0, wxALL, 5);
+        
+        scrubSizer->Add(new wxStaticText(scrubPanel, wxID_ANY, "MiB:"), 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        checkpointMemSpinner = new wxSpinCtrl(scrubPanel, wxID_ANY, "64", wxDefaultPosition, wxSize(70, -1), wxSP_ARROW_KEYS, 1, 4096, 64);
+        scrubSizer->Add(checkpointMemSpinner, 0, wxALL, 5);
+        
+        scrubSizer->Add(new wxStaticText(scrubPanel, wxID_ANY, "Ir a ciclo:"), 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        scrubSlider = new wxSlider(scrubPanel, wxID_ANY, 0, 0, 1, wxDefaultPosition, wxSize(300, -1), wxSL_HORIZONTAL | wxSL_LABELS);
+        scrubSlider->Enable(false);
+        scrubSizer->Add(scrubSlider, 0, wxALL, 5);
+        
+        scrubLabel = new wxStaticText(scrubPanel, wxID_ANY, "");
+        scrubSizer->Add(scrubLabel, 1, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        scrubPanel->SetSizer(scrubSizer);
+        mainSizer->Add(scrubPanel, 0, wxEXPAND | wxLEFT | wxRIGHT, 5);
+        
         wxSplitterWindow* splitter = new wxSplitterWindow(this);
         
         wxPanel* leftPanel = new wxPanel(splitter);
@@ -511,43 +1236,50 @@ public:
         
         loadButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnLoadProcesses, this);
         runButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnRunSimulation, this);
+        pauseButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnPauseResume, this);
+        stepButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnStep, this);
         clearButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnClear, this);
+        monteCarloButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnMonteCarlo, this);
+        exportButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnExportGantt, this);
+        saveResultsButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnSaveResults, this);
+        openResultsButton->Bind(wxEVT_BUTTON, &SchedulingPanel::OnOpenResults, this);
+        speedSpinner->Bind(wxEVT_SPINCTRL, &SchedulingPanel::OnSpeedChanged, this);
+        scrubSlider->Bind(wxEVT_SLIDER, &SchedulingPanel::OnScrub, this);
+        
+        simulationTimer.SetOwner(this);
+        Bind(wxEVT_TIMER, &SchedulingPanel::OnTimer, this, simulationTimer.GetId());
     }
     
     void OnLoadProcesses(wxCommandEvent& event) {
         wxFileDialog openFileDialog(this, "Cargar archivo de procesos", "", "",
-                                    "Archivos de texto (*.txt)|*.txt", wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+                                    "Archivos de texto (*.txt)|*.txt|"
+                                    "Traza perf sched / ftrace (*.txt;*.trace;*.perf)|*.txt;*.trace;*.perf",
+                                    wxFD_OPEN | wxFD_FILE_MUST_EXIST);
         
         if (openFileDialog.ShowModal() == wxID_OK) {
-            procesos = leerProcesosDesdeArchivo(openFileDialog.GetPath().ToStdString());
+            if (openFileDialog.GetFilterIndex() == 1) {
+                long usPorCiclo = wxGetNumberFromUser("Microsegundos de traza por ciclo simulado",
+                                                      "us/ciclo:", "Importar traza", 1000, 1, 1000000, this);
+                if (usPorCiclo <= 0) return;
+                
+                OpcionesImportacion opciones;
+                opciones.usPorCiclo = usPorCiclo;
+                EstadisticasImportacion estadisticas;
+                procesos = leerTrazaSched(openFileDialog.GetPath().ToStdString(), opciones, &estadisticas);
+                if (estadisticas.ignoradas > 0) {
+                    wxLogWarning("Se ignoraron %lld eventos que no se pudieron interpretar", estadisticas.ignoradas);
+                }
+            } else {
+                procesos = leerProcesosDesdeArchivo(openFileDialog.GetPath().ToStdString());
+            }
             
             ganttPanel->Clear();
+            ResetScrubber();
             
-            std::vector<wxColour> predefinedColors = {
-                wxColour(255, 100, 100),  // Rojo claro
-                wxColour(100, 255, 100),  // Verde claro
-                wxColour(100, 100, 255),  // Azul claro
-                wxColour(255, 255, 100),  // Amarillo
-                wxColour(255, 100, 255),  // Magenta
-                wxColour(100, 255, 255),  // Cyan
-                wxColour(255, 180, 100),  // Naranja
-                wxColour(180, 100, 255),  // Púrpura
-                wxColour(255, 180, 180),  // Rosa claro
-                wxColour(180, 255, 180)   // Verde menta
-            };
-            
+            // Los mismos colores que usa la exportación sin GUI
             for (size_t i = 0; i < procesos.size(); i++) {
-                wxColour color;
-                if (i < predefinedColors.size()) {
-                    color = predefinedColors[i];
-                } else {
-                    int r = 100 + ((i * 67) % 156);
-                    int g = 100 + ((i * 89) % 156);
-                    int b = 100 + ((i * 113) % 156);
-                    color = wxColour(r, g, b);
-                }
-                
-                ganttPanel->SetProcessColor(procesos[i].pid, color);
+                ColorRGB color = colorProceso(i);
+                ganttPanel->SetProcessColor(procesos[i].pid, wxColour(color.r, color.g, color.b));
             }
             
             infoPanel->ShowProcesses(procesos);
@@ -569,91 +1301,358 @@ public:
             return;
         }
         
+        traza.reset();
+        if (traceCheck->GetValue()) {
+            wxFileDialog saveFileDialog(this, "Guardar traza de la simulacion", "", "traza_simulacion.json",
+                                        "Chrome trace (*.json)|*.json", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+            if (saveFileDialog.ShowModal() != wxID_OK) {
+                return;
+            }
+            traza = std::make_shared<TrazaSimulacion>(saveFileDialog.GetPath().ToStdString());
+            if (!traza->abierta()) {
+                wxMessageBox("No se pudo escribir " + saveFileDialog.GetPath(), "Error", wxICON_ERROR);
+                traza.reset();
+                return;
+            }
+        }
+        
         ganttPanel->Clear();
         metricsPanel->Clear();
+        ResetScrubber();
+        
+        runConfig = SimulationConfig();
+        runConfig.contextSwitch = contextSwitchSpinner->GetValue();
+        runConfig.traza = traza.get();
+        runConfig.guardarTimeline = false; // El Gantt arma el timeline desde el observador
+        
+        pendingAlgorithms.clear();
+        for (size_t i = 0; i < selections.GetCount(); i++) {
+            pendingAlgorithms.push_back(selections[i]);
+        }
         
-        stopSimulation = false;
         runButton->Enable(false);
+        pauseButton->Enable(true);
+        pauseButton->SetLabel("Pausar");
+        stepButton->Enable(false);
+        paused = false;
         
-        simulationThread = new std::thread([this, selections]() {
-            for (size_t i = 0; i < selections.GetCount() && !stopSimulation; i++) {
-                int algo = selections[i];
-                std::vector<Proceso> procesosTemp = procesos;
-                
-                // Iniciar nuevo algoritmo en el Gantt
-                wxTheApp->CallAfter([this, algo]() {
-                    ganttPanel->StartNewAlgorithm(algorithmNames[algo]);
-                });
-                
-                // Pequeña pausa para que se renderice
-                std::this_thread::sleep_for(std::chrono::milliseconds(200));
-                
-                // Callback para actualizar GUI
-                auto updateGUI = [this](const std::string& pid, int cycle) {
-                    wxTheApp->CallAfter([this, pid, cycle]() {
-                        ganttPanel->AddTimeSlot(pid, cycle);
-                    });
-                };
-                
-                SimulationResult result;
-                // Ejecutar algoritmo correspondiente
-                switch (algo) {
-                    case 0: // FIFO
-                        result = fifo(procesosTemp, updateGUI);
-                        break;
-                    case 1: // SJF
-                        result = sjf(procesosTemp, updateGUI);
-                        break;
-                    case 2: // SRT
-                        result = srt(procesosTemp, updateGUI);
-                        break;
-                    case 3: // Round Robin
-                        result = roundRobin(procesosTemp, quantumSpinner->GetValue(), updateGUI);
-                        break;
-                    case 4: // Priority
-                        result = priority(procesosTemp, updateGUI);
-                        break;
-                }
-                
-                // Finalizar algoritmo y actualizar métricas
-                wxTheApp->CallAfter([this, result, procesosTemp, algo]() {
-                    ganttPanel->FinishCurrentAlgorithm(result, procesosTemp);
-                    metricsPanel->AddAlgorithmMetrics(algorithmNames[algo], result, procesosTemp);
-                });
-                
-                // Pausa entre algoritmos si hay más de uno
-                if (i < selections.GetCount() - 1) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-                }
+        if (StartNextAlgorithm()) {
+            simulationTimer.Start(TimerInterval());
+        }
+    }
+    
+    // Prepara el motor del siguiente algoritmo seleccionado; false si ya no quedan
+    bool StartNextAlgorithm() {
+        if (pendingAlgorithms.empty()) {
+            FinishRun();
+            return false;
+        }
+        
+        currentAlgorithm = pendingAlgorithms.front();
+        pendingAlgorithms.erase(pendingAlgorithms.begin());
+        
+        if (traza) {
+            traza->iniciarAlgoritmo(algorithmNames[currentAlgorithm]);
+        }
+        ganttPanel->StartNewAlgorithm(algorithmNames[currentAlgorithm]);
+        
+        historial = std::make_shared<HistorialCheckpoints>(checkpointSpinner->GetValue(),
+                                                           (size_t)checkpointMemSpinner->GetValue() << 20);
+        SimulationConfig config = runConfig;
+        config.checkpoints = historial.get();
+        motor = crearMotor(static_cast<Algoritmo>(currentAlgorithm), procesos, config,
+                           quantumSpinner->GetValue());
+        motor->setObservador([this](const std::string& pid, int cycle) {
+            INSTR_ACUMULAR(NS_CALLBACK);
+            ganttPanel->AppendTimeSlot(pid, cycle);
+        });
+        return true;
+    }
+    
+    // Avanza la simulación. Con velocidad 0 corre hasta agotar un presupuesto
+    // de tiempo por tick del timer, así que el costo por ciclo del algoritmo
+    // no bloquea el ciclo de eventos; el Gantt se redibuja una vez por tick.
+    void AdvanceSimulation(bool singleStep) {
+        if (!motor) return;
+        
+        {
+            INSTR_FASE("simular");
+            if (singleStep || speedSpinner->GetValue() > 0) {
+                motor->step();
+            } else {
+                auto limite = std::chrono::steady_clock::now() + PRESUPUESTO_POR_TICK;
+                do {
+                    motor->runUntil(motor->cicloActual() + CICLOS_ENTRE_RELOJ);
+                } while (!motor->terminado() && std::chrono::steady_clock::now() < limite);
             }
+        }
+        ganttPanel->ShowLatest();
+        
+        if (motor->terminado()) {
+            INSTR_FASE("gui_metricas");
+            int lastCycle = motor->cicloActual() - 1;
+            const AlgorithmData& data = ganttPanel->FinishCurrentAlgorithm(motor->tomarResultado(), motor->tomarProcesos());
+            metricsPanel->AddAlgorithmMetrics(algorithmNames[currentAlgorithm], *data.result, data.procesos);
             
-            wxTheApp->CallAfter([this]() {
-                runButton->Enable(true);
-            });
+            reproducciones.push_back({currentAlgorithm, quantumSpinner->GetValue(), historial, nullptr});
+            scrubSlider->SetRange(0, std::max(scrubSlider->GetMax(), lastCycle));
+            scrubSlider->Enable(true);
+            
+            StartNextAlgorithm();
+        }
+    }
+    
+    void FinishRun() {
+        simulationTimer.Stop();
+        motor.reset();
+        if (traza) {
+            traza->cerrar();
+            traza.reset();
+        }
+        
+        runButton->Enable(true);
+        pauseButton->Enable(false);
+        stepButton->Enable(false);
+#ifdef SCHED_INSTRUMENTACION
+        if (instr::exportarTrazaChrome("traza_instrumentacion.json")) {
+            wxLogStatus("Traza de instrumentacion escrita en traza_instrumentacion.json");
+        }
+#endif
+    }
+    
+    int TimerInterval() const {
+        return std::max(1, speedSpinner->GetValue());
+    }
+    
+    void OnTimer(wxTimerEvent& event) {
+        AdvanceSimulation(false);
+    }
+    
+    void OnPauseResume(wxCommandEvent& event) {
+        if (!motor) return;
+        
+        paused = !paused;
+        if (paused) {
+            simulationTimer.Stop();
+            pauseButton->SetLabel("Reanudar");
+        } else {
+            simulationTimer.Start(TimerInterval());
+            pauseButton->SetLabel("Pausar");
+        }
+        stepButton->Enable(paused);
+    }
+    
+    void OnStep(wxCommandEvent& event) {
+        if (motor && paused) {
+            AdvanceSimulation(true);
+        }
+    }
+    
+    void OnSpeedChanged(wxSpinEvent& event) {
+        if (motor && !paused) {
+            simulationTimer.Start(TimerInterval());
+        }
+    }
+    
+    void ResetScrubber() {
+        reproducciones.clear();
+        historial.reset();
+        scrubSlider->SetRange(0, 1);
+        scrubSlider->SetValue(0);
+        scrubSlider->Enable(false);
+        scrubLabel->SetLabel("");
+    }
+    
+    // Restaura el checkpoint más cercano de cada algoritmo terminado y muestra
+    // quién tiene el CPU y la cola de listos al inicio del ciclo elegido
+    void OnScrub(wxCommandEvent& event) {
+        int cycle = scrubSlider->GetValue();
+        ganttPanel->SetCursorCycle(cycle);
+        
+        wxString text;
+        for (auto& [algorithm, quantum, historialAlgoritmo, reproductor] : reproducciones) {
+            if (!reproductor) {
+                reproductor = std::make_unique<ReproductorCheckpoints>(static_cast<Algoritmo>(algorithm), procesos,
+                                                                       quantum, runConfig, historialAlgoritmo);
+            }
+            const MotorCalendarizacion& estado = reproductor->irA(cycle);
+            const auto& ps = estado.procesos();
+            
+            text += wxString::Format("%s: CPU=", algorithmNames[algorithm]);
+            text += estado.procesoActual() >= 0 ? wxString(ps[estado.procesoActual()].pid) : wxString("-");
+            text += " | Cola:";
+            for (int idx : estado.colaListos()) {
+                text += wxString::Format(" %s(%d)", ps[idx].pid, ps[idx].remaining_time);
+            }
+            text += "   ";
+        }
+        scrubLabel->SetLabel(text);
+    }
+    
+    // Corre los algoritmos marcados sobre cargas aleatorias en todos los núcleos
+    void OnMonteCarlo(wxCommandEvent& event) {
+        wxArrayInt selections;
+        algorithmList->GetCheckedItems(selections);
+        if (selections.IsEmpty()) {
+            wxMessageBox("Debe seleccionar al menos un algoritmo", "Error", wxICON_ERROR);
+            return;
+        }
+        
+        MonteCarloDialog dialog(this);
+        if (dialog.ShowModal() != wxID_OK) {
+            return;
+        }
+        
+        ParametrosMonteCarlo parametros = dialog.GetParametros();
+        for (size_t i = 0; i < selections.GetCount(); i++) {
+            parametros.algoritmos.push_back(static_cast<Algoritmo>(selections[i]));
+        }
+        parametros.quantum = quantumSpinner->GetValue();
+        parametros.contextSwitch = contextSwitchSpinner->GetValue();
+        
+        std::atomic<int> progreso{0};
+        std::atomic<bool> listo{false};
+        parametros.progreso = &progreso;
+        int total = parametros.replicas * parametros.algoritmos.size();
+        
+        std::vector<ResumenMonteCarlo> resumen;
+        auto token = ejecutor.lanzar([&](EjecutorTrabajos::Token t) {
+            parametros.cancelacion = t.get();
+            resumen = correrMonteCarlo(parametros);
+            listo = true;
         });
+        
+        wxProgressDialog progressDialog("Monte Carlo", "Simulando replicas...", total, this,
+                                        wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT |
+                                        wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
+        while (!listo) {
+            if (!progressDialog.Update(std::min(progreso.load(), total - 1))) {
+                token->cancelar();
+                break;
+            }
+            wxMilliSleep(100);
+        }
+        ejecutor.esperarTodo();
+        if (token->cancelado()) {
+            return;
+        }
+        progressDialog.Update(total);
+        
+        MonteCarloResultDialog results(this, resumen, algorithmNames);
+        results.ShowModal();
     }
     
-    void OnClear(wxCommandEvent& event) {
-        stopSimulation = true;
-        if (simulationThread && simulationThread->joinable()) {
-            simulationThread->join();
-            delete simulationThread;
-            simulationThread = nullptr;
+    // Escribe todos los tracks del Gantt a SVG o a PNG en teselas. Se dibuja
+    // ranura por ranura desde los historiales, así que no depende del tamaño
+    // de la ventana ni carga el timeline completo en memoria
+    void OnExportGantt(wxCommandEvent& event) {
+        std::vector<TrackGantt> tracks = ganttPanel->GetExportTracks();
+        if (tracks.empty()) {
+            wxMessageBox("No hay ningún Gantt que exportar", "Error", wxICON_ERROR);
+            return;
+        }
+        
+        wxFileDialog saveFileDialog(this, "Exportar Gantt", "", "gantt",
+                                    "SVG (*.svg)|*.svg|PNG en teselas (*.png)|*.png",
+                                    wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+        if (saveFileDialog.ShowModal() != wxID_OK) {
+            return;
+        }
+        
+        std::string archivo = saveFileDialog.GetPath().ToStdString();
+        ColoresProceso colores = ganttPanel->GetExportColors();
+        wxBusyCursor busy;
+        if (saveFileDialog.GetFilterIndex() == 0) {
+            if (!exportarGanttSVG(archivo, tracks, colores)) {
+                wxMessageBox("No se pudo escribir " + archivo, "Error", wxICON_ERROR);
+                return;
+            }
+            wxMessageBox("Gantt exportado a " + archivo, "Información");
+        } else {
+            int teselas = exportarGanttPNG(archivo, tracks, colores);
+            if (teselas < 0) {
+                wxMessageBox("No se pudo escribir " + archivo, "Error", wxICON_ERROR);
+                return;
+            }
+            wxMessageBox(wxString::Format("Gantt exportado en %d archivo(s) PNG", teselas), "Información");
+        }
+    }
+    
+    // Guarda los tracks terminados (simulados o abiertos de otro archivo)
+    void OnSaveResults(wxCommandEvent& event) {
+        if (motor) {
+            wxMessageBox("Espere a que termine la simulación", "Error", wxICON_ERROR);
+            return;
+        }
+        std::vector<TrackResultados> tracks = ganttPanel->GetSaveTracks();
+        if (tracks.empty()) {
+            wxMessageBox("No hay resultados que guardar", "Error", wxICON_ERROR);
+            return;
+        }
+        
+        wxFileDialog saveFileDialog(this, "Guardar resultados", "", "resultados",
+                                    "Resultados (*.sres)|*.sres", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+        if (saveFileDialog.ShowModal() != wxID_OK) {
+            return;
+        }
+        
+        uint64_t hash = !procesos.empty() ? hashCarga(procesos)
+                      : resultadosAbiertos ? resultadosAbiertos->hashCarga() : 0;
+        std::string archivo = saveFileDialog.GetPath().ToStdString();
+        wxBusyCursor busy;
+        if (!guardarResultados(archivo, hash, tracks)) {
+            wxMessageBox("No se pudo escribir " + archivo, "Error", wxICON_ERROR);
+        }
+    }
+    
+    // Reemplaza el Gantt y las métricas por los de un archivo de resultados.
+    // Solo se leen las métricas generales; ranuras y filas salen del archivo
+    // mapeado a medida que se dibujan
+    void OnOpenResults(wxCommandEvent& event) {
+        if (motor) {
+            wxMessageBox("Espere a que termine la simulación", "Error", wxICON_ERROR);
+            return;
+        }
+        wxFileDialog openFileDialog(this, "Abrir resultados", "", "",
+                                    "Resultados (*.sres)|*.sres", wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+        if (openFileDialog.ShowModal() != wxID_OK) {
+            return;
+        }
+        
+        std::shared_ptr<const ArchivoResultados> archivo =
+            ArchivoResultados::abrir(openFileDialog.GetPath().ToStdString());
+        if (!archivo) {
+            wxMessageBox("No es un archivo de resultados válido", "Error", wxICON_ERROR);
+            return;
+        }
+        if (!procesos.empty() && archivo->hashCarga() != hashCarga(procesos)) {
+            wxLogWarning("Los resultados se generaron con una carga de procesos distinta a la cargada");
         }
         
+        ResetScrubber();
+        ganttPanel->Clear();
+        metricsPanel->Clear();
+        for (size_t t = 0; t < archivo->tracks(); t++) {
+            ganttPanel->AddSavedAlgorithm(archivo, t);
+            metricsPanel->AddAlgorithmMetrics(archivo, t);
+        }
+        resultadosAbiertos = std::move(archivo);
+    }
+    
+    void OnClear(wxCommandEvent& event) {
+        pendingAlgorithms.clear();
+        FinishRun();
+        ResetScrubber();
+        resultadosAbiertos.reset();
+        
         procesos.clear();
         ganttPanel->Clear();
         infoPanel->Clear();
         metricsPanel->Clear();
-        runButton->Enable(true);
     }
     
     ~SchedulingPanel() {
-        stopSimulation = true;
-        if (simulationThread && simulationThread->joinable()) {
-            simulationThread->join();
-            delete simulationThread;
-        }
+        simulationTimer.Stop();
     }
 };
 
@@ -661,6 +1660,11 @@ public:
 class SyncPanel : public wxPanel {
 private:
     wxRadioBox* syncModeRadio;
+    wxCheckBox* traceCheck;
+    wxChoice* rwPolicyChoice;
+    wxChoice* protocolChoice;
+    wxCheckBox* realThreadsCheck;
+    wxSpinCtrl* usPerCycleSpinner;
     wxButton* loadProcessesButton;
     wxButton* loadResourcesButton;
     wxButton* loadActionsButton;
@@ -674,18 +1678,19 @@ private:
     std::vector<Proceso> procesos;
     std::map<std::string, Recurso> recursos;
     std::vector<Accion> acciones;
-    std::thread* simulationThread = nullptr;
-    std::atomic<bool> stopSimulation{false};
-    
-    struct OperacionActiva {
-        std::string pid;
-        std::string recurso;
-        std::string tipo;
-        int ciclo_inicio;
-        int duracion;
-    };
+    EjecutorTrabajos ejecutor;
     
-    std::vector<OperacionActiva> operaciones_activas;
+    std::shared_ptr<TrazaSimulacion> traza;
+    
+    // El hilo de simulación publica instantáneas inmutables de los recursos;
+    // la GUI toma la más reciente una vez por cuadro (a lo sumo)
+    using InstantaneaRecursos = std::shared_ptr<const std::vector<Recurso>>;
+    InstantaneaRecursos instantaneaRecursos;
+    InstantaneaRecursos instantaneaMostrada;
+    wxTimer frameTimer;
+    static constexpr int MS_POR_CUADRO = 33;
+    static constexpr int CICLOS_USO_RECURSO = 3;       // Lo que dura cada uso de un recurso en este panel
+    static constexpr int CICLOS_SECCION_CRITICA = 3;   // Prioridad + Recursos: CPU con el recurso tomado
     
 public:
     SyncPanel(wxWindow* parent) : wxPanel(parent) {
@@ -697,10 +1702,36 @@ public:
         wxArrayString syncModes;
         syncModes.Add("Mutex");
         syncModes.Add("Semaforo");
+        syncModes.Add("Lectores/Escritores");
+        syncModes.Add("Prioridad + Recursos");
         syncModeRadio = new wxRadioBox(controlPanel, wxID_ANY, "Modo de Sincronizacion",
                                        wxDefaultPosition, wxDefaultSize, syncModes, 1, wxRA_SPECIFY_ROWS);
         controlSizer->Add(syncModeRadio, 0, wxALL, 5);
         
+        wxArrayString rwPolicies;
+        for (const char* nombre : NOMBRES_POLITICA_RW) rwPolicies.Add(nombre);
+        rwPolicyChoice = new wxChoice(controlPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, rwPolicies);
+        rwPolicyChoice->SetSelection(static_cast<int>(PoliticaRW::JUSTA));
+        controlSizer->Add(rwPolicyChoice, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        wxArrayString protocols;
+        for (const char* nombre : NOMBRES_PROTOCOLO) protocols.Add(nombre);
+        protocolChoice = new wxChoice(controlPanel, wxID_ANY, wxDefaultPosition, wxDefaultSize, protocols);
+        protocolChoice->SetSelection(static_cast<int>(ProtocoloPrioridad::NINGUNO));
+        controlSizer->Add(protocolChoice, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        traceCheck = new wxCheckBox(controlPanel, wxID_ANY, "Exportar traza");
+        controlSizer->Add(traceCheck, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        realThreadsCheck = new wxCheckBox(controlPanel, wxID_ANY, "Hilos reales");
+        controlSizer->Add(realThreadsCheck, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        
+        wxStaticText* usPerCycleLabel = new wxStaticText(controlPanel, wxID_ANY, "us/ciclo:");
+        controlSizer->Add(usPerCycleLabel, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+        usPerCycleSpinner = new wxSpinCtrl(controlPanel, wxID_ANY, "1000", wxDefaultPosition, wxSize(90, -1),
+                                           wxSP_ARROW_KEYS, 10, 1000000, 1000);
+        controlSizer->Add(usPerCycleSpinner, 0, wxALL, 5);
+        
         loadProcessesButton = new wxButton(controlPanel, wxID_ANY, "Cargar Procesos");
         loadResourcesButton = new wxButton(controlPanel, wxID_ANY, "Cargar Recursos");
         loadActionsButton = new wxButton(controlPanel, wxID_ANY, "Cargar Acciones");
@@ -741,6 +1772,9 @@ public:
         loadActionsButton->Bind(wxEVT_BUTTON, &SyncPanel::OnLoadActions, this);
         runButton->Bind(wxEVT_BUTTON, &SyncPanel::OnRunSimulation, this);
         clearButton->Bind(wxEVT_BUTTON, &SyncPanel::OnClear, this);
+        
+        frameTimer.SetOwner(this);
+        Bind(wxEVT_TIMER, &SyncPanel::OnFrame, this, frameTimer.GetId());
     }
     
     void OnLoadProcesses(wxCommandEvent& event) {
@@ -792,163 +1826,285 @@ public:
             return;
         }
         
+        bool isMutex = (syncModeRadio->GetSelection() == 0);
+        bool isReaderWriter = (syncModeRadio->GetSelection() == 2);
+        bool isPriority = (syncModeRadio->GetSelection() == 3);
+        PoliticaRW politica = static_cast<PoliticaRW>(rwPolicyChoice->GetSelection());
+        ProtocoloPrioridad protocolo = static_cast<ProtocoloPrioridad>(protocolChoice->GetSelection());
+        const char* modeName = isPriority ? "Prioridad + Recursos" : isReaderWriter ? "Lectores/Escritores"
+                             : isMutex ? "Mutex" : "Semaforo";
+        
+        // A lo sumo una simulación a la vez; la anterior termina en milisegundos
+        StopSimulation();
+        
+        if (realThreadsCheck->GetValue()) {
+            if (isReaderWriter || isPriority) {
+                wxMessageBox("Los hilos reales solo reproducen Mutex y Semaforo", "Error", wxICON_ERROR);
+                return;
+            }
+            RunRealThreads(isMutex);
+            return;
+        }
+        
+        traza.reset();
+        if (traceCheck->GetValue()) {
+            wxFileDialog saveFileDialog(this, "Guardar traza de la simulacion", "", "traza_sincronizacion.json",
+                                        "Chrome trace (*.json)|*.json", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+            if (saveFileDialog.ShowModal() != wxID_OK) {
+                return;
+            }
+            traza = std::make_shared<TrazaSimulacion>(saveFileDialog.GetPath().ToStdString());
+            if (!traza->abierta()) {
+                wxMessageBox("No se pudo escribir " + saveFileDialog.GetPath(), "Error", wxICON_ERROR);
+                traza.reset();
+                return;
+            }
+            traza->iniciarAlgoritmo(modeName);
+        }
+        
         ganttPanel->Clear();
-        stopSimulation = false;
         runButton->Enable(false);
         
-        bool isMutex = (syncModeRadio->GetSelection() == 0);
+        // El hilo trabaja sobre copias: la GUI puede recargar archivos sin
+        // competir con él por los mismos datos
+        instantaneaMostrada.reset();
+        frameTimer.Start(MS_POR_CUADRO);
         
-        simulationThread = new std::thread([this, isMutex]() {
+        // Lo encolado en la GUI revisa el token: tras cancelar (o destruir el
+        // panel) ya no toca la ventana
+        ejecutor.lanzar([this, isMutex, isReaderWriter, isPriority, politica, protocolo, procesos = procesos,
+                         recursos = recursos, acciones = acciones](EjecutorTrabajos::Token token) mutable {
             // Iniciar algoritmo único
-            wxTheApp->CallAfter([this, isMutex]() {
-                ganttPanel->StartNewAlgorithm(isMutex ? "Mutex" : "Semáforo");
+            wxTheApp->CallAfter([this, isMutex, isReaderWriter, isPriority, protocolo, token]() {
+                if (token->cancelado()) return;
+                ganttPanel->StartNewAlgorithm(isPriority ? std::string("Prioridad + ") + NOMBRES_PROTOCOLO[static_cast<int>(protocolo)]
+                                              : isReaderWriter ? "Lectores/Escritores" : isMutex ? "Mutex" : "Semáforo");
             });
             
-            if (isMutex) {
-                SimulateMutex();
+            std::vector<MetricasRW> metricas;
+            std::vector<ResultadoInversion> inversiones;
+            if (isPriority) {
+                SimulatePriorityInversion(procesos, recursos, acciones, protocolo, token);
+                inversiones = compararProtocolos(procesos, recursos, acciones, CICLOS_SECCION_CRITICA, token.get());
+            } else if (isReaderWriter) {
+                OpcionesSync opciones;
+                opciones.lectoresEscritores = true;
+                opciones.politicaRW = politica;
+                ReplaySync(recursos, acciones, opciones, token);
+                metricas = compararPoliticasRW(recursos, acciones, CICLOS_USO_RECURSO, token.get());
             } else {
-                SimulateSemaphore();
+                OpcionesSync opciones;
+                opciones.mutex = isMutex;
+                ReplaySync(recursos, acciones, opciones, token);
             }
             
-            wxTheApp->CallAfter([this]() {
+            if (traza) {
+                traza->cerrar();
+            }
+            
+            wxTheApp->CallAfter([this, token, metricas = std::move(metricas),
+                                 inversiones = std::move(inversiones)]() mutable {
+                if (token->cancelado()) return;
+                frameTimer.Stop();
+                RefreshResources();
                 runButton->Enable(true);
+                if (!metricas.empty()) {
+                    LectoresEscritoresDialog dialog(this, metricas, CICLOS_USO_RECURSO);
+                    dialog.ShowModal();
+                }
+                if (!inversiones.empty()) {
+                    InversionPrioridadDialog dialog(this, std::move(inversiones));
+                    dialog.ShowModal();
+                }
             });
         });
     }
     
-    void SimulateMutex() {
-        int ciclo = 0;
-        int max_ciclo = 0;
-        
-        for (const auto& a : acciones) {
-            if (a.ciclo > max_ciclo) max_ciclo = a.ciclo;
-        }
-        max_ciclo += 10;
-        
-        for (auto& [nombre, recurso] : recursos) {
-            recurso.ocupado = false;
-            recurso.proceso_actual = "";
-        }
-        
-        operaciones_activas.clear();
-        
-        for (; ciclo <= max_ciclo && !stopSimulation; ciclo++) {
-            // Procesar acciones del ciclo actual
-            for (const auto& a : acciones) {
-                if (a.ciclo == ciclo) {
-                    auto& recurso = recursos[a.recurso];
-                    std::string bloque;
-                    
-                    if (!recurso.ocupado) {
-                        recurso.ocupado = true;
-                        recurso.proceso_actual = a.pid;
-                        bloque = a.pid + "-" + a.tipo + "-" + a.recurso + "-ACCESSED";
-                        operaciones_activas.push_back({a.pid, a.recurso, a.tipo, ciclo, 2});
-                    } else {
-                        bloque = a.pid + "-" + a.tipo + "-" + a.recurso + "-WAITING";
-                    }
-                    
-                    wxTheApp->CallAfter([this, bloque, ciclo]() {
-                        ganttPanel->AddTimeSlot(bloque, ciclo);
-                    });
-                    
-                    wxTheApp->CallAfter([this]() {
-                        resourceInfoPanel->ShowResources(recursos);
-                    });
-                }
-            }
-            
-            // Liberar recursos que han terminado
-            std::vector<size_t> operaciones_terminadas;
-            for (size_t i = 0; i < operaciones_activas.size(); i++) {
-                auto& op = operaciones_activas[i];
-                if (ciclo >= op.ciclo_inicio + op.duracion) {
-                    recursos[op.recurso].ocupado = false;
-                    recursos[op.recurso].proceso_actual = "";
-                    operaciones_terminadas.push_back(i);
+    // Reproduce las acciones con un hilo del sistema por proceso y compara
+    // las esperas y latencias medidas con la predicción del modelo
+    void RunRealThreads(bool isMutex) {
+        runButton->Enable(false);
+        OpcionesContencion opciones;
+        opciones.mutex = isMutex;
+        opciones.usPorCiclo = usPerCycleSpinner->GetValue();
+        
+        ejecutor.lanzar([this, opciones, recursos = recursos, acciones = acciones](EjecutorTrabajos::Token token) {
+            ResultadoContencion resultado = medirContencionReal(recursos, acciones, opciones, token.get());
+            wxTheApp->CallAfter([this, opciones, acciones, token, resultado = std::move(resultado)]() mutable {
+                if (token->cancelado()) return;
+                runButton->Enable(true);
+                if (!resultado.error.empty()) {
+                    wxMessageBox(resultado.error, "Error", wxICON_ERROR);
+                    return;
                 }
-            }
-            
-            for (int i = operaciones_terminadas.size() - 1; i >= 0; i--) {
-                operaciones_activas.erase(operaciones_activas.begin() + operaciones_terminadas[i]);
-            }
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        }
+                ContencionRealDialog dialog(this, acciones, std::move(resultado), opciones);
+                dialog.ShowModal();
+            });
+        });
     }
     
-    void SimulateSemaphore() {
-        int ciclo = 0;
-        int max_ciclo = 0;
+    // Cancela la simulación en curso y espera a su hilo
+    void StopSimulation() {
+        ejecutor.cancelarTodo();
+        ejecutor.esperarTodo();
+        frameTimer.Stop();
+    }
+    
+    void PublishResources(const std::map<std::string, Recurso>& recursos) {
+        auto copia = std::make_shared<std::vector<Recurso>>();
+        copia->reserve(recursos.size());
+        for (const auto& [nombre, recurso] : recursos) copia->push_back(recurso);
+        std::atomic_store(&instantaneaRecursos, InstantaneaRecursos(std::move(copia)));
+    }
+    
+    void RefreshResources() {
+        InstantaneaRecursos actual = std::atomic_load(&instantaneaRecursos);
+        if (!actual || actual == instantaneaMostrada) return;
+        instantaneaMostrada = actual;
+        resourceInfoPanel->UpdateResources(std::move(actual));
+    }
+    
+    void OnFrame(wxTimerEvent& event) {
+        RefreshResources();
+    }
+    
+    // Simula mutex, semáforo o lectores/escritores una sola vez con
+    // simularSyncParticionado (el mismo modelo que usan simularMutex,
+    // simularSemaforo y la predicción de Hilos reales) y reproduce sus eventos
+    // con la pausa de la animación. En lectores/escritores quien no entra
+    // espera en cola y el Gantt muestra el ACCESSED en el ciclo en que entra.
+    void ReplaySync(std::map<std::string, Recurso>& recursos, const std::vector<Accion>& acciones,
+                    OpcionesSync opciones, const EjecutorTrabajos::Token& token) {
+        opciones.ciclosRetencion = CICLOS_USO_RECURSO;
+        opciones.cancelacion = token.get();
+        ResultadoSync resultado = simularSyncParticionado(recursos, acciones, opciones);
+        if (resultado.cancelado) return;
         
+        int max_ciclo = 0;
         for (const auto& a : acciones) {
             if (a.ciclo > max_ciclo) max_ciclo = a.ciclo;
         }
-        max_ciclo += 10;
+        max_ciclo = std::max(max_ciclo + 10, resultado.ultimoCiclo + 1);
         
         for (auto& [nombre, recurso] : recursos) {
+            recurso.ocupado = false;
+            recurso.proceso_actual = "";
             recurso.contador = recurso.contador_inicial;
             recurso.procesos_uso.clear();
         }
-        
-        for (; ciclo <= max_ciclo && !stopSimulation; ciclo++) {
-            // Procesar acciones del ciclo actual
-            for (const auto& a : acciones) {
-                if (a.ciclo == ciclo) {
-                    auto& recurso = recursos[a.recurso];
-                    std::string bloque;
-                    
-                    if (recurso.contador > 0) {
-                        recurso.contador--;
-                        recurso.procesos_uso[a.pid] = 3;
-                        bloque = a.pid + "-" + a.tipo + "-" + a.recurso + "-ACCESSED";
-                    } else {
-                        bloque = a.pid + "-" + a.tipo + "-" + a.recurso + "-WAITING";
-                    }
-                    
-                    wxTheApp->CallAfter([this, bloque, ciclo]() {
-                        ganttPanel->AddTimeSlot(bloque, ciclo);
-                    });
-                    
-                    wxTheApp->CallAfter([this]() {
-                        resourceInfoPanel->ShowResources(recursos);
-                    });
+        PublishResources(recursos);
+        
+        // Dueño exclusivo en proceso_actual; lectores y usos de semáforo en
+        // procesos_uso (pid -> último ciclo). El semáforo además descuenta
+        // contador por cada uso, aunque el mismo pid tenga varios a la vez.
+        const bool semaforo = !opciones.mutex && !opciones.lectoresEscritores;
+        struct Retencion {
+            std::string recurso;
+            std::string pid;
+            int fin;
+            bool compartido;
+        };
+        std::vector<Retencion> retenciones;
+        size_t e = 0;
+        
+        for (int ciclo = 0; ciclo <= max_ciclo && !token->cancelado(); ciclo++) {
+            bool cambio = false;
+            
+            // Liberar lo que terminó en el ciclo anterior
+            for (size_t i = 0; i < retenciones.size();) {
+                const Retencion& r = retenciones[i];
+                if (r.fin >= ciclo) {
+                    i++;
+                    continue;
+                }
+                auto& recurso = recursos[r.recurso];
+                if (!r.compartido) {
+                    recurso.ocupado = false;
+                    recurso.proceso_actual = "";
+                } else if (recurso.procesos_uso[r.pid] == r.fin) {
+                    recurso.procesos_uso.erase(r.pid);
+                }
+                if (semaforo) {
+                    recurso.contador++;
                 }
+                retenciones[i] = retenciones.back();
+                retenciones.pop_back();
+                cambio = true;
             }
             
-            // Liberar recursos que han terminado
-            for (auto& [nombre, recurso] : recursos) {
-                std::vector<std::string> procesos_terminados;
-                
-                for (auto& [pid, tiempo_restante] : recurso.procesos_uso) {
-                    tiempo_restante--;
-                    if (tiempo_restante <= 0) {
-                        recurso.contador++;
-                        procesos_terminados.push_back(pid);
+            for (; e < resultado.eventos.size() && resultado.eventos[e].ciclo == ciclo; ++e) {
+                const EventoSync& evento = resultado.eventos[e];
+                const Accion& a = acciones[evento.accion];
+                auto& recurso = recursos[a.recurso];
+                std::string bloque = a.pid + "-" + a.tipo + "-" + a.recurso +
+                                     (evento.accedio ? "-ACCESSED" : "-WAITING");
+                if (evento.accedio) {
+                    bool compartido = semaforo || (opciones.lectoresEscritores && a.tipo == "READ");
+                    int fin = ciclo + CICLOS_USO_RECURSO - 1;
+                    if (compartido) {
+                        recurso.procesos_uso[a.pid] = fin;
+                    } else {
+                        recurso.ocupado = true;
+                        recurso.proceso_actual = a.pid;
+                    }
+                    if (semaforo) {
+                        recurso.contador--;
                     }
+                    retenciones.push_back({a.recurso, a.pid, fin, compartido});
                 }
+                cambio = true;
                 
-                for (const auto& pid : procesos_terminados) {
-                    recurso.procesos_uso.erase(pid);
+                if (traza) {
+                    traza->eventoSync(a.recurso, bloque, ciclo);
                 }
+                
+                wxTheApp->CallAfter([this, bloque, ciclo, token]() {
+                    if (token->cancelado()) return;
+                    ganttPanel->AddTimeSlot(bloque, ciclo);
+                });
+            }
+            
+            // Una instantánea por ciclo, y sólo si algo cambió
+            if (cambio) {
+                PublishResources(recursos);
             }
             
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            if (token->esperar(std::chrono::milliseconds(500))) break;
         }
     }
     
+    // Planificador por prioridad expropiativo sobre los procesos cargados,
+    // que toman los recursos de las acciones como mutex. El Gantt muestra
+    // quién corre, qué recursos retiene y con qué prioridad efectiva.
+    void SimulatePriorityInversion(const std::vector<Proceso>& procesos, std::map<std::string, Recurso>& recursos,
+                                   const std::vector<Accion>& acciones, ProtocoloPrioridad protocolo,
+                                   const EjecutorTrabajos::Token& token) {
+        OpcionesInversion opciones;
+        opciones.protocolo = protocolo;
+        opciones.ciclosSeccion = CICLOS_SECCION_CRITICA;
+        SimulationConfig config;
+        config.traza = traza.get();
+        config.cancelacion = token.get();
+        
+        // El simulador corre en este hilo y deja `recursos` al día antes de cada aviso
+        UpdateCallback aviso = [this, &recursos, token](const std::string& bloque, int ciclo) {
+            PublishResources(recursos);
+            wxTheApp->CallAfter([this, bloque, ciclo, token]() {
+                if (token->cancelado()) return;
+                ganttPanel->AddTimeSlot(bloque, ciclo);
+            });
+        };
+        simularInversionPrioridad(procesos, recursos, acciones, opciones, aviso, config);
+    }
+    
     void OnClear(wxCommandEvent& event) {
-        stopSimulation = true;
-        if (simulationThread && simulationThread->joinable()) {
-            simulationThread->join();
-            delete simulationThread;
-            simulationThread = nullptr;
-        }
+        StopSimulation();
+        std::atomic_store(&instantaneaRecursos, InstantaneaRecursos());
+        instantaneaMostrada.reset();
         
         procesos.clear();
         recursos.clear();
         acciones.clear();
-        operaciones_activas.clear();
         ganttPanel->Clear();
         processInfoPanel->Clear();
         resourceInfoPanel->Clear();
@@ -957,11 +2113,7 @@ public:
     }
     
     ~SyncPanel() {
-        stopSimulation = true;
-        if (simulationThread && simulationThread->joinable()) {
-            simulationThread->join();
-            delete simulationThread;
-        }
+        StopSimulation();
     }
 };
 
@@ -0,0 +1,162 @@
+#include "montecarlo.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
+const char* const NOMBRES_METRICAS_MC[MC_NUM_METRICAS] = {
+    "Waiting Time Promedio",
+    "TurnAround Promedio",
+    "Response Time Promedio",
+    "Waiting Time p95",
+    "Cambios de Contexto",
+    "Utilizacion de CPU",
+    "Throughput",
+    "Makespan"
+};
+
+std::vector<Proceso> generarCarga(const DistribucionCarga& d, uint64_t semilla) {
+    std::mt19937_64 gen(semilla);
+    std::exponential_distribution<> entreLlegadas(d.tasaLlegada > 0 ? d.tasaLlegada : 1.0);
+    std::uniform_int_distribution<> uniforme(d.rafagaMin, std::max(d.rafagaMin, d.rafagaMax));
+    std::exponential_distribution<> exponencial(1.0 / std::max(1e-9, d.rafagaMedia - d.rafagaMin + 1));
+    std::bernoulli_distribution larga(d.fraccionLargas);
+    std::discrete_distribution<> prioridad(d.pesosPrioridad.begin(), d.pesosPrioridad.end());
+
+    auto acotar = [&](double valor) {
+        return std::clamp((int)valor, d.rafagaMin, std::max(d.rafagaMin, d.rafagaMax));
+    };
+
+    auto rafagaCPU = [&](std::mt19937_64& g) {
+        switch (d.rafaga) {
+            case DistribucionCarga::Rafaga::EXPONENCIAL:
+                return acotar(d.rafagaMin + exponencial(g));
+            case DistribucionCarga::Rafaga::BIMODAL:
+                // Muchas ráfagas cortas y unas pocas cercanas al máximo
+                return larga(g) ? acotar(d.rafagaMax - exponencial(g) / 4)
+                                : acotar(d.rafagaMin + exponencial(g));
+            case DistribucionCarga::Rafaga::UNIFORME:
+                break;
+        }
+        return uniforme(g);
+    };
+
+    // La E/S usa su propio generador: con la misma semilla, agregar E/S no
+    // cambia llegadas, ráfagas iniciales ni prioridades
+    std::mt19937_64 genES(semilla ^ 0x9e3779b97f4a7c15ULL);
+    std::bernoulli_distribution conES(std::clamp(d.fraccionES, 0.0, 1.0));
+    std::exponential_distribution<> duracionES(1.0 / std::max(1.0, d.duracionESMedia));
+    std::uniform_int_distribution<> dispositivo(0, std::max(1, d.dispositivosES) - 1);
+
+    std::vector<Proceso> procesos(std::max(0, d.procesos));
+    double llegada = 0;
+    for (size_t i = 0; i < procesos.size(); ++i) {
+        Proceso& p = procesos[i];
+        p.pid = "P" + std::to_string(i + 1);
+        p.burst_time = rafagaCPU(gen);
+        p.arrival_time = (int)llegada;
+        p.priority = d.pesosPrioridad.empty() ? 1 : prioridad(gen) + 1;
+        p.remaining_time = p.burst_time;
+        llegada += entreLlegadas(gen);
+
+        if (d.fraccionES > 0 && conES(genES)) {
+            for (int r = 0; r < d.rafagasES; ++r) {
+                p.es.push_back({dispositivo(genES), 1 + (int)duracionES(genES), rafagaCPU(genES)});
+            }
+        }
+    }
+    return procesos;
+}
+
+namespace {
+
+// t de Student de dos colas al 95% para gl grados de libertad
+double tStudent95(int gl) {
+    static const double tabla[] = {
+        0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (gl <= 0) return 0;
+    if (gl <= 30) return tabla[gl];
+    // Expansión de Cornish-Fisher alrededor de la normal
+    double z = 1.959964;
+    return z + (z * z * z + z) / (4.0 * gl) + (5 * std::pow(z, 5) + 16 * z * z * z + 3 * z) / (96.0 * gl * gl);
+}
+
+void extraer(const SimulationResult& r, double* valores) {
+    valores[MC_ESPERA] = r.avgWaitingTime;
+    valores[MC_RETORNO] = r.avgTurnaroundTime;
+    valores[MC_RESPUESTA] = r.avgResponseTime;
+    valores[MC_ESPERA_P95] = r.waiting.cuantil(0.95);
+    valores[MC_CAMBIOS_CONTEXTO] = r.contextSwitches;
+    valores[MC_UTILIZACION] = r.cpuUtilization;
+    valores[MC_THROUGHPUT] = r.throughput;
+    valores[MC_MAKESPAN] = r.makespan;
+}
+
+}
+
+std::vector<ResumenMonteCarlo> correrMonteCarlo(const ParametrosMonteCarlo& parametros) {
+    const int replicas = std::max(0, parametros.replicas);
+    const int numAlgoritmos = parametros.algoritmos.size();
+    const int corridas = replicas * numAlgoritmos;
+
+    // Una fila de métricas por corrida, en orden fijo: [réplica][algoritmo]
+    std::vector<double> valores((size_t)corridas * MC_NUM_METRICAS);
+    std::atomic<int> siguiente{0};
+
+    SimulationConfig config;
+    config.contextSwitch = parametros.contextSwitch;
+    config.guardarTimeline = false;
+    config.soloMetricas = true;
+    config.cancelacion = parametros.cancelacion;
+    auto cancelado = [&]() { return parametros.cancelacion && parametros.cancelacion->cancelado(); };
+
+    auto trabajador = [&]() {
+        for (int corrida = siguiente++; corrida < corridas && !cancelado(); corrida = siguiente++) {
+            int replica = corrida / numAlgoritmos;
+            std::vector<Proceso> carga = generarCarga(parametros.distribucion, parametros.semilla + replica);
+            SimulationResult r = correrAlgoritmo(parametros.algoritmos[corrida % numAlgoritmos], carga,
+                                                 config, parametros.quantum);
+            extraer(r, &valores[(size_t)corrida * MC_NUM_METRICAS]);
+            if (parametros.progreso) {
+                parametros.progreso->fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    unsigned hilos = parametros.hilos ? parametros.hilos : std::thread::hardware_concurrency();
+    hilos = std::max(1u, std::min<unsigned>(hilos, std::max(1, corridas)));
+    std::vector<std::thread> trabajadores;
+    for (unsigned i = 1; i < hilos; ++i) {
+        trabajadores.emplace_back(trabajador);
+    }
+    trabajador();
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+    if (cancelado()) {
+        return {};
+    }
+
+    std::vector<ResumenMonteCarlo> resumen(numAlgoritmos);
+    double t = tStudent95(replicas - 1);
+    for (int a = 0; a < numAlgoritmos; ++a) {
+        resumen[a].algoritmo = parametros.algoritmos[a];
+        resumen[a].replicas = replicas;
+        for (int m = 0; m < MC_NUM_METRICAS; ++m) {
+            // Welford: media y varianza en una pasada
+            double media = 0, m2 = 0;
+            for (int r = 0; r < replicas; ++r) {
+                double x = valores[((size_t)r * numAlgoritmos + a) * MC_NUM_METRICAS + m];
+                double delta = x - media;
+                media += delta / (r + 1);
+                m2 += delta * (x - media);
+            }
+            double desviacion = replicas > 1 ? std::sqrt(m2 / (replicas - 1)) : 0;
+            resumen[a].metricas[m] = {media, replicas > 1 ? t * desviacion / std::sqrt((double)replicas) : 0};
+        }
+    }
+    return resumen;
+}
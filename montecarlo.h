@@ -0,0 +1,72 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+#include "motor.h"
+#include <atomic>
+#include <cstdint>
+
+// Distribución de las cargas aleatorias para el modo Monte Carlo
+struct DistribucionCarga {
+    enum class Rafaga { UNIFORME, EXPONENCIAL, BIMODAL };
+
+    int procesos = 100;
+    double tasaLlegada = 0.1;         // Procesos por ciclo (llegadas de Poisson)
+    Rafaga rafaga = Rafaga::UNIFORME;
+    int rafagaMin = 1;
+    int rafagaMax = 20;               // Uniforme en [min, max]; tope para las demás
+    double rafagaMedia = 8;           // Exponencial; en bimodal, media de las ráfagas cortas
+    double fraccionLargas = 0.2;      // Bimodal: fracción de ráfagas cercanas a rafagaMax
+    std::vector<double> pesosPrioridad = {1, 1, 1, 1, 1}; // Peso de la prioridad i + 1
+
+    // Procesos limitados por E/S: alternan rafagasES veces E/S y CPU
+    double fraccionES = 0;
+    int rafagasES = 3;
+    double duracionESMedia = 10;      // Exponencial, al menos 1 ciclo
+    int dispositivosES = 1;           // Cada ráfaga va a un dispositivo al azar
+};
+
+std::vector<Proceso> generarCarga(const DistribucionCarga& distribucion, uint64_t semilla);
+
+// Media con intervalo de confianza del 95% (media ± mitad)
+struct Intervalo {
+    double media = 0;
+    double mitad = 0;
+};
+
+enum MetricaMonteCarlo {
+    MC_ESPERA,
+    MC_RETORNO,
+    MC_RESPUESTA,
+    MC_ESPERA_P95,
+    MC_CAMBIOS_CONTEXTO,
+    MC_UTILIZACION,
+    MC_THROUGHPUT,
+    MC_MAKESPAN,
+    MC_NUM_METRICAS
+};
+
+extern const char* const NOMBRES_METRICAS_MC[MC_NUM_METRICAS];
+
+struct ResumenMonteCarlo {
+    Algoritmo algoritmo;
+    int replicas = 0;
+    Intervalo metricas[MC_NUM_METRICAS];
+};
+
+struct ParametrosMonteCarlo {
+    DistribucionCarga distribucion;
+    std::vector<Algoritmo> algoritmos;
+    int replicas = 100;
+    int quantum = 2;
+    int contextSwitch = 0;
+    uint64_t semilla = 1;
+    unsigned hilos = 0;                         // 0 = std::thread::hardware_concurrency()
+    std::atomic<int>* progreso = nullptr;       // Corridas terminadas, para la GUI
+    const TokenCancelacion* cancelacion = nullptr;
+};
+
+// Genera las réplicas y corre cada algoritmo sobre cada una en paralelo. Todos
+// los algoritmos ven las mismas cargas en cada réplica y el resultado no
+// depende del número de hilos. Si se cancela devuelve un vector vacío.
+std::vector<ResumenMonteCarlo> correrMonteCarlo(const ParametrosMonteCarlo& parametros);
+
+#endif
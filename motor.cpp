@@ -0,0 +1,116 @@
+#include "motor.h"
+#include <algorithm>
+
+EstadoMotor::EstadoMotor(std::vector<Proceso> procesos, const SimulationConfig& config)
+    : procesos(std::move(procesos)), config(config) {
+    // Reiniciar el estado de simulación de cada proceso
+    int numDispositivos = 0;
+    for (auto& p : this->procesos) {
+        p.remaining_time = p.burst_time;
+        p.start_time = -1;
+        p.terminado = false;
+        p.en_cola = false;
+        p.fase = 0;
+        p.en_es = false;
+        for (const auto& r : p.es) {
+            numDispositivos = std::max(numDispositivos, r.dispositivo + 1);
+        }
+    }
+
+    dispositivos.reserve(numDispositivos);
+    for (int d = 0; d < numDispositivos; ++d) {
+        dispositivos.emplace_back(&arena);
+    }
+    result.ciclosOcupadosES.assign(numDispositivos, 0);
+
+    if (this->procesos.empty()) {
+        calcularMetricas(result);
+    }
+}
+
+void EstadoMotor::enviarAES(int idx) {
+    Proceso& p = procesos[idx];
+    const RafagaES& r = p.es[p.fase];
+    DispositivoES& d = dispositivos[r.dispositivo];
+    if (d.cola.empty()) {
+        d.restante = r.duracion;
+    }
+    d.cola.push_back(idx);
+    p.en_es = true;
+}
+
+void EstadoMotor::avanzarES() {
+    volvieronDeES.clear();
+    for (size_t d = 0; d < dispositivos.size(); ++d) {
+        DispositivoES& disp = dispositivos[d];
+        if (disp.cola.empty()) continue;
+
+        result.ciclosOcupadosES[d]++;
+        if (--disp.restante > 0) continue;
+
+        int idx = disp.cola.front();
+        disp.cola.pop_front();
+        Proceso& p = procesos[idx];
+        p.en_es = false;
+        p.fase++;
+        p.remaining_time = rafagaActual(p);
+        volvieronDeES.push_back(idx);
+
+        if (!disp.cola.empty()) {
+            const Proceso& q = procesos[disp.cola.front()];
+            disp.restante = q.es[q.fase].duracion;
+        }
+    }
+}
+
+// La espera incluye la cola de listos y las colas de los dispositivos
+void PoliticaBase::calcularTiempos(Proceso& p) const {
+    p.turnaround_time = p.completion_time - p.arrival_time;
+    p.waiting_time = p.turnaround_time - cpuTotal(p) - esTotal(p);
+    p.response_time = p.start_time - p.arrival_time;
+}
+
+std::unique_ptr<MotorCalendarizacion> crearMotor(Algoritmo algoritmo, std::vector<Proceso> procesos,
+                                                 const SimulationConfig& config, int quantum) {
+    switch (algoritmo) {
+        case Algoritmo::FIFO:
+            return std::make_unique<MotorFIFO>(std::move(procesos), config);
+        case Algoritmo::SJF:
+            return std::make_unique<MotorSJF>(std::move(procesos), config);
+        case Algoritmo::SRT:
+            return std::make_unique<MotorSRT>(std::move(procesos), config);
+        case Algoritmo::ROUND_ROBIN:
+            return std::make_unique<MotorRoundRobin>(std::move(procesos), config, SeleccionRoundRobin{},
+                                                     ExpropiacionPorQuantum{quantum});
+        case Algoritmo::PRIORITY:
+            return std::make_unique<MotorPriority>(std::move(procesos), config);
+        case Algoritmo::LOTTERY:
+            return std::make_unique<MotorLottery>(std::move(procesos), config, SeleccionLottery{},
+                                                  ExpropiacionPorQuantum{quantum});
+        case Algoritmo::STRIDE:
+            return std::make_unique<MotorStride>(std::move(procesos), config, SeleccionStride{},
+                                                 ExpropiacionPorQuantum{quantum});
+    }
+    return nullptr;
+}
+
+SimulationResult correrAlgoritmo(Algoritmo algoritmo, std::vector<Proceso>& procesos,
+                                 const SimulationConfig& config, int quantum) {
+    switch (algoritmo) {
+        case Algoritmo::FIFO:
+            return fifo(procesos, nullptr, config);
+        case Algoritmo::SJF:
+            return sjf(procesos, nullptr, config);
+        case Algoritmo::SRT:
+            return srt(procesos, nullptr, config);
+        case Algoritmo::ROUND_ROBIN:
+            return roundRobin(procesos, quantum, nullptr, config);
+        case Algoritmo::PRIORITY:
+            return priority(procesos, nullptr, config);
+        case Algoritmo::LOTTERY:
+            return lottery(procesos, quantum, nullptr, config);
+        case Algoritmo::STRIDE:
+            return stride(procesos, quantum, nullptr, config);
+    }
+    return SimulationResult();
+}
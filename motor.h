@@ -0,0 +1,528 @@
+#ifndef MOTOR_H
+#define MOTOR_H
+#include "scheduler.h"
+#include "instrumentacion.h"
+#include "cancelacion.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <deque>
+#include <queue>
+
+enum class Algoritmo { FIFO, SJF, SRT, ROUND_ROBIN, PRIORITY, LOTTERY, STRIDE };
+
+// Estado compacto de un motor al inicio de un ciclo. Solo se guardan los
+// procesos vivos que ya cambiaron respecto a su estado inicial; los
+// terminados se guardan como tramos de índices [inicio, fin).
+struct Checkpoint {
+    struct EstadoProceso {
+        int idx;
+        int remaining_time;
+        int start_time;
+        bool en_cola;
+        int fase;
+        bool en_es;
+    };
+
+    int tiempo = 0;
+    int completados = 0;
+    int actual = -1;
+    int ciclosEnCpu = 0;
+    int csPendiente = 0;
+    std::string ultimo;
+    std::vector<std::pair<int, int>> terminados;
+    std::vector<EstadoProceso> vivos;
+    std::vector<int> extra; // Estado propio de la política (cola de RR, siguiente de FIFO)
+    std::vector<int> colasES; // Por dispositivo: restante, longitud y procesos en cola
+
+    size_t bytes() const;
+};
+
+// Checkpoints tomados cada `intervalo` ciclos durante una corrida. Si se
+// excede el presupuesto de memoria se descarta uno de cada dos y el
+// intervalo se duplica.
+class HistorialCheckpoints {
+public:
+    HistorialCheckpoints(int intervalo, size_t presupuestoBytes);
+
+    // El motor lo consulta al inicio de cada ciclo antes de capturar
+    bool pendiente(int ciclo) const { return ciclo >= proximo; }
+    void agregar(Checkpoint c);
+    // Último checkpoint con tiempo <= ciclo (búsqueda binaria), nullptr si no hay
+    const Checkpoint* buscar(int ciclo) const;
+
+    int intervalo() const { return intervalo_; }
+    size_t bytes() const { return bytes_; }
+    size_t cantidad() const { return checkpoints.size(); }
+
+private:
+    void recortar();
+
+    int intervalo_;
+    size_t presupuesto;
+    size_t bytes_ = 0;
+    int proximo = 0;
+    std::vector<Checkpoint> checkpoints;
+};
+
+// Dispositivo de E/S: atiende su cola en orden de llegada, un proceso a la vez
+struct DispositivoES {
+    explicit DispositivoES(std::pmr::memory_resource* memoria) : cola(memoria) {}
+
+    std::pmr::deque<int> cola;   // El frente es el proceso en servicio
+    int restante = 0;            // Ciclos de E/S que le faltan al frente
+};
+
+// Estado de calendarización común a todas las políticas
+struct EstadoMotor {
+    EstadoMotor(std::vector<Proceso> procesos, const SimulationConfig& config);
+
+    bool terminado() const { return completados == (int)procesos.size(); }
+    // Procesos que ya llegaron y esperan el CPU, en orden de índice
+    std::vector<int> listosPorLlegada() const;
+
+    // Snapshot sin el estado propio de la política. restaurar() no reconstruye
+    // las métricas acumuladas: se usa para reproducir e inspeccionar el calendario.
+    Checkpoint capturar() const;
+    void restaurar(const Checkpoint& c);
+
+    // El proceso terminó una ráfaga de CPU y pasa a la cola de su dispositivo
+    void enviarAES(int idx);
+    // Avanza un ciclo todos los dispositivos; deja en volvieronDeES los
+    // procesos que terminaron su E/S y ya pueden volver a la CPU
+    void avanzarES();
+
+    std::vector<Proceso> procesos;
+    SimulationConfig config;
+    SimulationResult result;
+    int tiempo = 0;
+    int completados = 0;
+    int actual = -1;        // Proceso que tiene o recibe el CPU (-1 si ninguno)
+    int ciclosEnCpu = 0;    // Ciclos consecutivos del proceso actual
+    int csPendiente = 0;    // Ciclos de cambio de contexto por emitir
+    std::string ultimo;     // Último proceso que tuvo el CPU
+
+    // Memoria de trabajo de la corrida (colas de las políticas). Se libera
+    // completa al destruir el motor en lugar de bloque por bloque.
+    std::pmr::unsynchronized_pool_resource arena;
+
+    // Vacío si ningún proceso hace E/S: el ciclo del motor no paga nada extra
+    std::vector<DispositivoES> dispositivos;
+    std::vector<int> volvieronDeES;
+};
+
+// Política de selección: elige qué proceso recibe el CPU. PoliticaBase da los
+// valores por omisión; cada política oculta sólo lo que necesita y el motor
+// resuelve las llamadas en compilación, sin funciones virtuales.
+struct PoliticaBase {
+    void preparar(EstadoMotor& e) {}
+    // Se llama después de cada ciclo ejecutado por el proceso actual
+    void despuesDeCiclo(EstadoMotor& e) {}
+    // Recibe el proceso que soltó el CPU sin terminar
+    void alExpropiar(EstadoMotor& e, int idx) {}
+    // Recibe el proceso que terminó su E/S; las políticas que recorren todos
+    // los procesos no necesitan hacer nada
+    void alVolverDeES(EstadoMotor& e, int idx) {}
+    void calcularTiempos(Proceso& p) const;
+    std::vector<int> colaListos(const EstadoMotor& e) const { return e.listosPorLlegada(); }
+    void guardar(std::vector<int>& extra) const {}
+    // Se llama con el estado ya restaurado
+    void restaurar(const EstadoMotor& e, const std::vector<int>& extra) {}
+};
+
+struct SeleccionFIFO : PoliticaBase {
+    void preparar(EstadoMotor& e);
+    int seleccionar(EstadoMotor& e);
+    void alVolverDeES(EstadoMotor& e, int idx) { regresos->push_back({idx, e.tiempo}); }
+    void guardar(std::vector<int>& extra) const;
+    void restaurar(const EstadoMotor& e, const std::vector<int>& extra);
+
+    int siguiente = 0;
+
+private:
+    // Procesos que volvieron de E/S, con el ciclo en que quedaron listos
+    std::optional<std::pmr::deque<std::pair<int, int>>> regresos;
+};
+
+struct SeleccionSJF : PoliticaBase {
+    int seleccionar(EstadoMotor& e);
+};
+
+struct SeleccionSRT : PoliticaBase {
+    int seleccionar(EstadoMotor& e);
+};
+
+struct SeleccionRoundRobin : PoliticaBase {
+    void preparar(EstadoMotor& e);
+    int seleccionar(EstadoMotor& e);
+    void despuesDeCiclo(EstadoMotor& e) { admitir(e); }
+    void alExpropiar(EstadoMotor& e, int idx);
+    void alVolverDeES(EstadoMotor& e, int idx);
+    std::vector<int> colaListos(const EstadoMotor& e) const;
+    void guardar(std::vector<int>& extra) const;
+    void restaurar(const EstadoMotor& e, const std::vector<int>& extra);
+
+private:
+    void admitir(EstadoMotor& e);
+    // Se construye en preparar() para que tome memoria de la arena del motor
+    std::optional<std::queue<int, std::pmr::deque<int>>> cola;
+};
+
+struct SeleccionPriority : PoliticaBase {
+    int seleccionar(EstadoMotor& e);
+    void calcularTiempos(Proceso& p) const;
+    std::vector<int> colaListos(const EstadoMotor& e) const;
+};
+
+// Reparto proporcional: los boletos salen de la prioridad (menor número =
+// más boletos: 1 -> 1000, 2 -> 500, 20 -> 50), así que un proceso recibe CPU
+// en proporción inversa a su número de prioridad
+inline int boletos(const Proceso& p) {
+    return std::max(1, 1000 / std::max(1, p.priority));
+}
+
+// Árbol de Fenwick sobre los boletos de cada proceso: actualizar y sortear
+// cuestan O(log n)
+class ArbolFenwick {
+public:
+    void reiniciar(int n);
+    void sumar(int i, long long delta);
+    long long total() const { return total_; }
+    // Menor i cuya suma acumulada [0, i] es mayor que r (0 <= r < total())
+    int buscar(long long r) const;
+
+private:
+    std::vector<long long> arbol;
+    long long total_ = 0;
+    int escalon = 1; // Mayor potencia de 2 <= n
+};
+
+// Las políticas proporcionales admiten en orden de llegada y marcan en_cola
+// en los admitidos, así que el checkpoint ya sabe quién entró; restaurar()
+// reconstruye el árbol o el montículo desde el estado.
+struct SeleccionLottery : PoliticaBase {
+    void preparar(EstadoMotor& e);
+    int seleccionar(EstadoMotor& e);
+    void alExpropiar(EstadoMotor& e, int idx);
+    void alVolverDeES(EstadoMotor& e, int idx);
+    void guardar(std::vector<int>& extra) const;
+    void restaurar(const EstadoMotor& e, const std::vector<int>& extra);
+
+private:
+    static constexpr uint64_t SEMILLA = 0x9E3779B97F4A7C15ULL; // Fija para repetir las corridas
+
+    void admitir(EstadoMotor& e);
+
+    std::vector<int> porLlegada;
+    int siguiente = 0;
+    int listos = 0;          // Procesos con boletos en el árbol
+    uint64_t azar = SEMILLA; // Estado de splitmix64
+    ArbolFenwick arbol;
+};
+
+struct SeleccionStride : PoliticaBase {
+    void preparar(EstadoMotor& e);
+    int seleccionar(EstadoMotor& e);
+    void despuesDeCiclo(EstadoMotor& e);
+    void alExpropiar(EstadoMotor& e, int idx);
+    void alVolverDeES(EstadoMotor& e, int idx);
+    std::vector<int> colaListos(const EstadoMotor& e) const;
+    void guardar(std::vector<int>& extra) const;
+    void restaurar(const EstadoMotor& e, const std::vector<int>& extra);
+
+private:
+    static constexpr long long STRIDE1 = 1 << 20;
+    static constexpr long long SIN_PASE = -1; // No ha llegado o ya terminó
+
+    void admitir(EstadoMotor& e);
+
+    std::vector<int> porLlegada;
+    int siguiente = 0;
+    // Cada ciclo de CPU suma STRIDE1 / boletos al pase; gana el menor pase.
+    // Quien llega o vuelve de E/S entra con el pase global (el del último
+    // elegido) para no acumular crédito mientras no compite.
+    std::vector<long long> pase;
+    long long paseGlobal = 0;
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>,
+                        std::greater<std::pair<long long, int>>> heap;
+};
+
+// Políticas de expropiación: true si el proceso actual debe soltar el CPU
+struct SinExpropiacion {
+    bool operator()(const EstadoMotor& e) const { return false; }
+};
+
+struct ExpropiacionSiempre {
+    bool operator()(const EstadoMotor& e) const { return true; }
+};
+
+struct ExpropiacionPorQuantum {
+    int quantum = 2;
+    bool operator()(const EstadoMotor& e) const { return e.ciclosEnCpu >= quantum; }
+};
+
+// Observadores de ciclo. Con ObservadorNulo el ciclo del motor no hace
+// ninguna llamada indirecta.
+struct ObservadorNulo {
+    void operator()(const std::string& contenido, int ciclo) const {}
+};
+
+struct ObservadorCallback {
+    UpdateCallback callback;
+    void operator()(const std::string& contenido, int ciclo) {
+        if (callback) {
+            INSTR_CONTAR(LLAMADAS_CALLBACK);
+            callback(contenido, ciclo);
+        }
+    }
+};
+
+// Motor de calendarización con estado propio. Cada step() simula exactamente
+// un ciclo (un proceso, IDLE o CS) y lo notifica al observador; el motor no
+// duerme ni crea hilos, así que la GUI decide el ritmo y las corridas sin
+// interfaz avanzan a toda velocidad con runToEnd().
+template <class Seleccion, class Expropiacion, class Observador = ObservadorNulo>
+class MotorPoliticas {
+public:
+    MotorPoliticas(std::vector<Proceso> procesos, const SimulationConfig& config,
+                   Seleccion seleccion = {}, Expropiacion expropiacion = {}, Observador observador = {})
+        : estado(std::move(procesos), config), seleccion(std::move(seleccion)),
+          expropiacion(expropiacion), observador(std::move(observador)) {
+        this->seleccion.preparar(estado);
+    }
+
+    // Avanza un ciclo. Devuelve false si todos los procesos ya terminaron.
+    bool step();
+    // Avanza hasta que el reloj llegue a ciclo (o hasta terminar o cancelar)
+    // Se consulta el token en cada ciclo: SRT y Priority recorren todos los
+    // procesos por ciclo, así que espaciar las consultas alargaría la espera
+    void runUntil(int ciclo) {
+        while (estado.tiempo < ciclo && !cancelado() && step()) {
+        }
+    }
+    void runToEnd() {
+        while (!cancelado() && step()) {
+        }
+    }
+    bool cancelado() const { return estado.config.cancelacion && estado.config.cancelacion->cancelado(); }
+
+    Checkpoint capturar() const {
+        Checkpoint c = estado.capturar();
+        seleccion.guardar(c.extra);
+        return c;
+    }
+    void restaurar(const Checkpoint& c) {
+        estado.restaurar(c);
+        seleccion.restaurar(estado, c.extra);
+    }
+
+    EstadoMotor estado;
+    Seleccion seleccion;
+    Expropiacion expropiacion;
+    Observador observador;
+
+private:
+    void emitir(const std::string& contenido) {
+        anotarCiclo(contenido, estado.tiempo, estado.result, estado.config);
+        observador(contenido, estado.tiempo);
+        estado.tiempo++;
+
+        // Los dispositivos trabajan en paralelo con la CPU, también en IDLE y CS
+        if (!estado.dispositivos.empty()) {
+            estado.avanzarES();
+            for (int idx : estado.volvieronDeES) {
+                seleccion.alVolverDeES(estado, idx);
+            }
+        }
+    }
+};
+
+template <class Seleccion, class Expropiacion, class Observador>
+bool MotorPoliticas<Seleccion, Expropiacion, Observador>::step() {
+    EstadoMotor& e = estado;
+    if (e.terminado()) return false;
+
+    if (e.config.checkpoints && e.config.checkpoints->pendiente(e.tiempo)) {
+        e.config.checkpoints->agregar(capturar());
+    }
+
+    if (e.csPendiente > 0) {
+        e.csPendiente--;
+        emitir("CS");
+        return true;
+    }
+
+    if (e.actual == -1) {
+        int idx;
+        {
+            INSTR_ACUMULAR(NS_SELECCION);
+            idx = seleccion.seleccionar(e);
+        }
+        if (idx == -1) {
+            emitir("IDLE");
+            return true;
+        }
+
+        e.actual = idx;
+        e.ciclosEnCpu = 0;
+        const std::string& pid = e.procesos[idx].pid;
+        if (!e.ultimo.empty() && e.ultimo != pid) {
+            e.result.contextSwitches++;
+            e.csPendiente = e.config.contextSwitch;
+        }
+        e.ultimo = pid;
+
+        if (e.csPendiente > 0) {
+            e.csPendiente--;
+            emitir("CS");
+            return true;
+        }
+    }
+
+    Proceso& p = e.procesos[e.actual];
+    if (p.start_time == -1) {
+        p.start_time = e.tiempo;
+    }
+    emitir(p.pid);
+    p.remaining_time--;
+    e.ciclosEnCpu++;
+    seleccion.despuesDeCiclo(e);
+
+    if (p.remaining_time == 0 && p.fase < (int)p.es.size()) {
+        // Fin de una ráfaga intermedia: la CPU queda libre mientras hace E/S
+        e.enviarAES(e.actual);
+        e.actual = -1;
+    } else if (p.remaining_time == 0) {
+        p.completion_time = e.tiempo;
+        seleccion.calcularTiempos(p);
+        p.terminado = true;
+        registrarTerminado(e.result, p);
+        e.completados++;
+        e.actual = -1;
+        if (e.terminado()) {
+            calcularMetricas(e.result);
+        }
+    } else if (expropiacion(e)) {
+        seleccion.alExpropiar(e, e.actual);
+        e.actual = -1;
+    }
+    return true;
+}
+
+// Corre una política hasta el final. Sin callback se usa el observador nulo,
+// así que el ciclo del motor queda sin llamadas indirectas.
+template <class Seleccion, class Expropiacion>
+SimulationResult correrPoliticas(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                                 const SimulationConfig& config, Seleccion seleccion = {},
+                                 Expropiacion expropiacion = {}) {
+    if (!updateGUI) {
+        MotorPoliticas<Seleccion, Expropiacion> motor(std::move(procesos), config,
+                                                      std::move(seleccion), expropiacion);
+        motor.runToEnd();
+        procesos = std::move(motor.estado.procesos);
+        return std::move(motor.estado.result);
+    }
+
+    MotorPoliticas<Seleccion, Expropiacion, ObservadorCallback> motor(
+        std::move(procesos), config, std::move(seleccion), expropiacion, ObservadorCallback{std::move(updateGUI)});
+    motor.runToEnd();
+    procesos = std::move(motor.estado.procesos);
+    return std::move(motor.estado.result);
+}
+
+// Interfaz dinámica para quien elige el algoritmo en tiempo de ejecución
+// (GUI, reproducción de checkpoints). Cada llamada virtual cubre un step()
+// o una corrida completa, no cada decisión de la política.
+class MotorCalendarizacion {
+public:
+    virtual ~MotorCalendarizacion() = default;
+
+    virtual bool step() = 0;
+    virtual void runUntil(int ciclo) = 0;
+    virtual void runToEnd() = 0;
+    virtual void setObservador(UpdateCallback cb) = 0;
+    // Índices de los procesos que esperan el CPU, en el orden de la política
+    virtual std::vector<int> colaListos() const = 0;
+    virtual Checkpoint capturar() const = 0;
+    virtual void restaurar(const Checkpoint& c) = 0;
+
+    bool terminado() const { return estado().terminado(); }
+    int cicloActual() const { return estado().tiempo; }
+    // Proceso que tiene el CPU o lo recibe tras el cambio de contexto (-1 si ninguno)
+    int procesoActual() const { return estado().actual; }
+
+    const SimulationResult& resultado() const { return estado().result; }
+    const std::vector<Proceso>& procesos() const { return estado().procesos; }
+    SimulationResult tomarResultado() { return std::move(estado().result); }
+    std::vector<Proceso> tomarProcesos() { return std::move(estado().procesos); }
+    // Igual que tomar*, pero ya como objetos inmutables compartidos
+    ResultadoCompartido publicarResultado() { return std::make_shared<const SimulationResult>(tomarResultado()); }
+    ProcesosCompartidos publicarProcesos() { return std::make_shared<const std::vector<Proceso>>(tomarProcesos()); }
+
+protected:
+    virtual EstadoMotor& estado() = 0;
+    virtual const EstadoMotor& estado() const = 0;
+};
+
+template <class Seleccion, class Expropiacion>
+class MotorDinamico : public MotorCalendarizacion {
+public:
+    MotorDinamico(std::vector<Proceso> procesos, const SimulationConfig& config,
+                  Seleccion seleccion = {}, Expropiacion expropiacion = {})
+        : motor(std::move(procesos), config, std::move(seleccion), expropiacion) {}
+
+    bool step() override { return motor.step(); }
+    void runUntil(int ciclo) override { motor.runUntil(ciclo); }
+    void runToEnd() override { motor.runToEnd(); }
+    void setObservador(UpdateCallback cb) override { motor.observador.callback = std::move(cb); }
+    std::vector<int> colaListos() const override { return motor.seleccion.colaListos(motor.estado); }
+    Checkpoint capturar() const override { return motor.capturar(); }
+    void restaurar(const Checkpoint& c) override { motor.restaurar(c); }
+
+protected:
+    EstadoMotor& estado() override { return motor.estado; }
+    const EstadoMotor& estado() const override { return motor.estado; }
+
+private:
+    MotorPoliticas<Seleccion, Expropiacion, ObservadorCallback> motor;
+};
+
+using MotorFIFO = MotorDinamico<SeleccionFIFO, SinExpropiacion>;
+using MotorSJF = MotorDinamico<SeleccionSJF, SinExpropiacion>;
+using MotorSRT = MotorDinamico<SeleccionSRT, ExpropiacionSiempre>;
+using MotorRoundRobin = MotorDinamico<SeleccionRoundRobin, ExpropiacionPorQuantum>;
+using MotorPriority = MotorDinamico<SeleccionPriority, SinExpropiacion>;
+using MotorLottery = MotorDinamico<SeleccionLottery, ExpropiacionPorQuantum>;
+using MotorStride = MotorDinamico<SeleccionStride, ExpropiacionPorQuantum>;
+
+std::unique_ptr<MotorCalendarizacion> crearMotor(Algoritmo algoritmo, std::vector<Proceso> procesos,
+                                                 const SimulationConfig& config, int quantum = 2);
+
+// Con config.soloMetricas, FIFO, SJF y Priority sin E/S se resuelven con un
+// ordenamiento y un barrido vectorizado (forma_cerrada.cpp), sin simular
+// ciclos. Devuelve nullopt si no aplica (otro algoritmo, traza, checkpoints).
+std::optional<SimulationResult> formaCerrada(Algoritmo algoritmo, std::vector<Proceso>& procesos,
+                                             const SimulationConfig& config);
+
+// Corrida completa sin observador (ciclo del motor sin llamadas indirectas)
+SimulationResult correrAlgoritmo(Algoritmo algoritmo, std::vector<Proceso>& procesos,
+                                 const SimulationConfig& config, int quantum = 2);
+
+// Reconstruye cualquier ciclo de una corrida ya registrada: restaura el
+// checkpoint más cercano y reproduce hacia adelante sin timeline ni GUI.
+class ReproductorCheckpoints {
+public:
+    ReproductorCheckpoints(Algoritmo algoritmo, std::vector<Proceso> procesos, int quantum,
+                           const SimulationConfig& config, std::shared_ptr<const HistorialCheckpoints> historial);
+
+    // Deja el motor de reproducción al inicio del ciclo pedido
+    const MotorCalendarizacion& irA(int ciclo);
+
+private:
+    std::unique_ptr<MotorCalendarizacion> motor;
+    std::shared_ptr<const HistorialCheckpoints> historial;
+};
+
+#endif
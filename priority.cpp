@@ -1,54 +1,54 @@
-#include "scheduler.h"
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
 #include <climits>
-#include <thread>
-#include <chrono>
 
-SimulationResult priority(std::vector<Proceso>& procesos, UpdateCallback updateGUI) {
-    int tiempo = 0, completados = 0, n = procesos.size();
-    SimulationResult result;
-
-    while (completados < n) {
-        int idx = -1, min_prio = INT_MAX;
-
-        // Buscar el proceso de mayor prioridad sin importar el arrival_time
-        for (int i = 0; i < n; ++i) {
-            if (!procesos[i].terminado && procesos[i].priority < min_prio) {
-                min_prio = procesos[i].priority;
+int SeleccionPriority::seleccionar(EstadoMotor& e) {
+    int n = e.procesos.size();
+    int idx = -1, min_prio = INT_MAX, listos = 0;
+
+    // Buscar el proceso de mayor prioridad sin importar el arrival_time
+    INSTR_CONTAR_N(ITERACIONES_SELECCION, n);
+    for (int i = 0; i < n; ++i) {
+        if (!e.procesos[i].terminado && !e.procesos[i].en_es) {
+            listos++;
+            if (e.procesos[i].priority < min_prio) {
+                min_prio = e.procesos[i].priority;
                 idx = i;
             }
         }
-
-        if (idx != -1) {
-            auto& p = procesos[idx];
-            p.waiting_time = tiempo; 
-			// No entendi muy bien lo que pusieron en discord, pero si se toma en cuenta el arrival time
-			// para el tiempo entonces:
-			// p.waiting_time = tiempo - p.arrival_time;
-
-            for (int i = 0; i < p.burst_time; ++i) {
-                result.timeline.push_back({p.pid, tiempo});
-                if (updateGUI) {
-                    updateGUI(p.pid, tiempo);
-                    std::this_thread::sleep_for(std::chrono::milliseconds(300));
-                }
-                tiempo++;
-            }
-
-            p.turnaround_time = p.waiting_time + p.burst_time;
-            p.terminado = true;
-            completados++;
-        }
     }
 
-    double total_wait = 0, total_tat = 0;
-    for (const auto& p : procesos) {
-        total_wait += p.waiting_time;
-        total_tat += p.turnaround_time;
+    if (e.config.traza && idx != -1) {
+        e.config.traza->colaListos(e.tiempo, listos - 1);
     }
+    return idx;
+}
 
-    result.avgWaitingTime = total_wait / procesos.size();
-    result.avgTurnaroundTime = total_tat / procesos.size();
+std::vector<int> SeleccionPriority::colaListos(const EstadoMotor& e) const {
+    std::vector<int> listos;
+    for (int i = 0; i < (int)e.procesos.size(); ++i) {
+        if (i != e.actual && !e.procesos[i].terminado && !e.procesos[i].en_es) {
+            listos.push_back(i);
+        }
+    }
+    return listos;
+}
 
-    return result;
+// No entendi muy bien lo que pusieron en discord, pero si se toma en cuenta el arrival time
+// para el tiempo entonces el waiting seria start_time - arrival_time
+void SeleccionPriority::calcularTiempos(Proceso& p) const {
+    p.turnaround_time = p.completion_time;
+    p.waiting_time = p.turnaround_time - cpuTotal(p) - esTotal(p);
+    p.response_time = p.start_time;
 }
 
+SimulationResult priority(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                          const SimulationConfig& config) {
+    if (!updateGUI) {
+        if (auto result = formaCerrada(Algoritmo::PRIORITY, procesos, config)) {
+            return std::move(*result);
+        }
+    }
+    return correrPoliticas<SeleccionPriority, SinExpropiacion>(procesos, std::move(updateGUI), config);
+}
@@ -3,21 +3,44 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
 #include <map>
+#include <array>
+#include <cstdint>
+#include <climits>
+
+// Ráfaga de E/S en un dispositivo seguida de la siguiente ráfaga de CPU
+struct RafagaES {
+    int dispositivo;
+    int duracion;
+    int cpu;
+};
 
 struct Proceso {
     std::string pid;
-    int burst_time;
+    int burst_time;          // Primera ráfaga de CPU (la única si no hay E/S)
     int arrival_time;
     int priority;
     int waiting_time = 0;
     int turnaround_time = 0;
     int remaining_time = 0;
     int start_time = -1;
+    int response_time = 0;
+    int completion_time = 0;
     bool terminado = false;
     bool en_cola = false;
+    std::vector<RafagaES> es; // E/S -> CPU alternados después de burst_time
+    int fase = 0;             // Ráfagas de E/S ya completadas
+    bool en_es = false;       // Esperando o usando un dispositivo
 };
 
+// Ráfaga de CPU en curso y demanda total del proceso
+inline int rafagaActual(const Proceso& p) {
+    return p.fase == 0 ? p.burst_time : p.es[p.fase - 1].cpu;
+}
+int cpuTotal(const Proceso& p);
+int esTotal(const Proceso& p);
+
 struct Recurso {
     std::string nombre;
     int contador;
@@ -36,27 +59,118 @@ struct Accion {
 
 using UpdateCallback = std::function<void(const std::string& pid, int cycle)>;
 
+class HistorialCheckpoints;
+class TrazaSimulacion;
+class TokenCancelacion;
+
+// Parametros configurables de la simulacion
+struct SimulationConfig {
+    int contextSwitch = 0;           // Ciclos no productivos por cada cambio de contexto
+    bool guardarTimeline = true;     // false: no materializar result.timeline
+    bool soloMetricas = false;       // Sin timeline; FIFO, SJF y Priority sin E/S en forma cerrada
+    TrazaSimulacion* traza = nullptr; // Exportacion opcional en streaming
+    HistorialCheckpoints* checkpoints = nullptr; // Snapshots periodicos (ver motor.h)
+    const TokenCancelacion* cancelacion = nullptr; // Corta la corrida; el resultado queda con avgWaitingTime = -1
+};
+
+// Distribucion de tiempos en memoria constante: histograma log-lineal con
+// valores exactos por debajo de 64 y error relativo menor a 3% por encima.
+class SketchCuantiles {
+public:
+    void agregar(int valor);
+    double cuantil(double q) const;
+    double promedio() const { return cantidad_ ? (double)suma_ / cantidad_ : 0; }
+    int maximo() const { return maximo_; }
+    long long cantidad() const { return cantidad_; }
+
+private:
+    friend struct CodecSketch; // Guardado en archivo_resultados.cpp
+
+    static constexpr int SUBCUBETAS = 32;
+    static constexpr int EXACTOS = 2 * SUBCUBETAS;
+    static constexpr int NUM_CUBETAS = EXACTOS + (31 - 6) * SUBCUBETAS;
+
+    static int indice(int valor);
+    static double valorRepresentativo(int indice);
+
+    std::array<uint64_t, NUM_CUBETAS> cubetas_{};
+    long long cantidad_ = 0;
+    long long suma_ = 0;
+    int maximo_ = 0;
+};
+
 struct SimulationResult {
     std::vector<std::pair<std::string, int>> timeline;
-    double avgWaitingTime;
-    double avgTurnaroundTime;
+    double avgWaitingTime = -1; // -1 mientras el algoritmo no ha terminado
+    double avgTurnaroundTime = 0;
+    double avgResponseTime = 0;
+    int contextSwitches = 0;
+    int makespan = 0;
+    double cpuUtilization = 0;   // Fraccion de ciclos con trabajo util
+    double throughput = 0;       // Procesos completados por ciclo
+    std::vector<double> utilizacionES; // Fraccion de ciclos ocupados de cada dispositivo
+
+    // Tiempos por proceso, alimentados conforme cada proceso termina
+    SketchCuantiles waiting;
+    SketchCuantiles turnaround;
+    SketchCuantiles response;
+
+    // Acumuladores para makespan y utilizacion
+    long long ciclosOcupados = 0;
+    std::vector<long long> ciclosOcupadosES;
+    int primerCiclo = INT_MAX;
+    int ultimoCiclo = 0;
 };
 
+// Resultados publicados: inmutables y compartidos entre el motor y la GUI,
+// se entregan por movimiento sin copiar timeline ni procesos
+using ResultadoCompartido = std::shared_ptr<const SimulationResult>;
+using ProcesosCompartidos = std::shared_ptr<const std::vector<Proceso>>;
+
+// Una línea de procesos.txt; false si no tiene los cuatro campos. Lanza
+// std::invalid_argument si algún número no se puede leer.
+bool leerProceso(const std::string& linea, Proceso& p);
 std::vector<Proceso> leerProcesosDesdeArchivo(const std::string& filename);
 std::map<std::string, Recurso> leerRecursosDesdeArchivo(const std::string& filename);
 std::vector<Accion> leerAccionesDesdeArchivo(const std::string& filename);
 
-// Funciones de algoritmos de calendarización
-SimulationResult fifo(std::vector<Proceso>& procesos, UpdateCallback updateGUI);
-SimulationResult sjf(std::vector<Proceso>& procesos, UpdateCallback updateGUI);
-SimulationResult srt(std::vector<Proceso>& procesos, UpdateCallback updateGUI);
-SimulationResult roundRobin(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI);
-SimulationResult priority(std::vector<Proceso>& procesos, UpdateCallback updateGUI);
+// Funciones de algoritmos de calendarización. Corren hasta terminar sin
+// pausas; para avanzar ciclo a ciclo se usan los motores de motor.h.
+SimulationResult fifo(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                      const SimulationConfig& config = SimulationConfig());
+SimulationResult sjf(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                     const SimulationConfig& config = SimulationConfig());
+SimulationResult srt(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                     const SimulationConfig& config = SimulationConfig());
+SimulationResult roundRobin(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI,
+                            const SimulationConfig& config = SimulationConfig());
+SimulationResult priority(std::vector<Proceso>& procesos, UpdateCallback updateGUI,
+                          const SimulationConfig& config = SimulationConfig());
+// Reparto proporcional con boletos según la prioridad, expropiando cada quantum
+SimulationResult lottery(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI,
+                         const SimulationConfig& config = SimulationConfig());
+SimulationResult stride(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI,
+                        const SimulationConfig& config = SimulationConfig());
+
+// Utilidades compartidas por los algoritmos
+// anotarCiclo guarda el ciclo en el timeline y la traza; registrarCiclo además avisa al callback
+void anotarCiclo(const std::string& contenido, int tiempo, SimulationResult& result,
+                 const SimulationConfig& config);
+void registrarCiclo(const std::string& contenido, int tiempo, SimulationResult& result,
+                    const SimulationConfig& config, UpdateCallback& updateGUI);
+void registrarTerminado(SimulationResult& result, const Proceso& p);
+void calcularMetricas(SimulationResult& result);
+// Pausa de animación de los simuladores; con config.cancelacion termina en
+// cuanto se cancela. Devuelve true si la corrida fue cancelada.
+bool pausaAnimacion(const SimulationConfig& config, int ms);
+bool corridaCancelada(const SimulationConfig& config);
 
 // Funciones de sincronización
 void simularMutex(std::vector<Proceso>& procesos, std::map<std::string, Recurso>& recursos, 
-                  std::vector<Accion>& acciones, UpdateCallback updateGUI);
+                  std::vector<Accion>& acciones, UpdateCallback updateGUI,
+                  const SimulationConfig& config = SimulationConfig());
 void simularSemaforo(std::vector<Proceso>& procesos, std::map<std::string, Recurso>& recursos, 
-                     std::vector<Accion>& acciones, UpdateCallback updateGUI);
+                     std::vector<Accion>& acciones, UpdateCallback updateGUI,
+                     const SimulationConfig& config = SimulationConfig());
 
 #endif
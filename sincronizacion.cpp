@@ -0,0 +1,384 @@
+#include "sincronizacion.h"
+#include "cancelacion.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+
+const char* const NOMBRES_POLITICA_RW[3] = {"Preferir lectores", "Preferir escritores", "Justa"};
+
+namespace {
+
+// Orden estable de los índices por una clave entera (el ciclo). Con un rango
+// pequeño (lo normal: varias acciones por ciclo) basta un conteo.
+template <typename Clave>
+std::vector<int> ordenPorClave(const std::vector<int>& indices, Clave clave) {
+    std::vector<int> orden(indices.size());
+    if (indices.empty()) return orden;
+    auto [menor, mayor] = std::minmax_element(indices.begin(), indices.end(),
+                                              [&](int a, int b) { return clave(a) < clave(b); });
+    int base = clave(*menor);
+    long long rango = (long long)clave(*mayor) - base + 1;
+    if (rango > (long long)std::max<size_t>(indices.size(), 1024)) {
+        orden = indices;
+        std::stable_sort(orden.begin(), orden.end(), [&](int a, int b) { return clave(a) < clave(b); });
+        return orden;
+    }
+    std::vector<int> inicio(rango + 1, 0);
+    for (int i : indices) inicio[clave(i) - base + 1]++;
+    std::partial_sum(inicio.begin(), inicio.end(), inicio.begin());
+    for (int i : indices) orden[inicio[clave(i) - base]++] = i;
+    return orden;
+}
+
+std::vector<int> ordenPorCiclo(const std::vector<Accion>& acciones, const std::vector<int>& indices) {
+    return ordenPorClave(indices, [&](int i) { return acciones[i].ciclo; });
+}
+
+// Estado de un recurso dentro de su partición
+struct EstadoRecurso {
+    int capacidad;
+    std::priority_queue<int, std::vector<int>, std::greater<>> fines; // Último ciclo de cada retención vigente
+};
+
+// Acumulados de lectores/escritores de una partición
+struct AcumuladoRW {
+    long long ciclosLector = 0;
+    long long ciclosConLectores = 0;
+    int maxLectores = 0;
+};
+
+bool esLectura(const Accion& a) { return a.tipo == "READ"; }
+
+// Un recurso en modo lectores/escritores. `llegadas` viene en orden de ciclo
+// y de archivo. Sólo se visitan los ciclos con llegadas o, si hay cola, los
+// ciclos en que se libera alguna retención.
+void simularRecursoRW(const std::vector<Accion>& acciones, const std::vector<int>& llegadas, PoliticaRW politica,
+                      int retencion, int* otorgado, int& ultimoCiclo, AcumuladoRW& acumulado) {
+    std::priority_queue<int, std::vector<int>, std::greater<>> lectores; // Último ciclo de cada lector
+    int finEscritor = INT_MIN;
+    int finLectura = INT_MIN;      // Para contar una sola vez los ciclos con varios lectores
+    std::deque<int> cola;
+    int escritoresEnCola = 0;
+
+    auto otorgar = [&](int i, int t) {
+        otorgado[i] = t;
+        int fin = t + retencion - 1;
+        ultimoCiclo = std::max(ultimoCiclo, fin);
+        if (!esLectura(acciones[i])) {
+            finEscritor = fin;
+            return;
+        }
+        lectores.push(fin);
+        acumulado.ciclosLector += retencion;
+        acumulado.maxLectores = std::max(acumulado.maxLectores, (int)lectores.size());
+        // Los otorgamientos llegan en orden de t y la retención es fija: fin no decrece
+        acumulado.ciclosConLectores += t > finLectura ? retencion : fin - finLectura;
+        finLectura = fin;
+    };
+    // Otorga, en orden de cola, las entradas que cumplan `puede`
+    auto otorgarDeCola = [&](int t, bool soloPrimera, auto puede) {
+        for (auto it = cola.begin(); it != cola.end();) {
+            if (!puede(*it)) {
+                ++it;
+                continue;
+            }
+            escritoresEnCola -= !esLectura(acciones[*it]);
+            otorgar(*it, t);
+            it = cola.erase(it);
+            if (soloPrimera) return;
+        }
+    };
+
+    auto atenderCola = [&](int t) {
+        const bool escritorActivo = finEscritor >= t;
+        if (escritorActivo || cola.empty()) return;
+        auto lectura = [&](int i) { return esLectura(acciones[i]); };
+        auto escritura = [&](int i) { return !esLectura(acciones[i]); };
+        switch (politica) {
+        case PoliticaRW::JUSTA:
+            // El frente entra; detrás de él, sólo lectores mientras no haya escritor
+            while (!cola.empty()) {
+                int i = cola.front();
+                if (finEscritor >= t || (escritura(i) && !lectores.empty())) break;
+                escritoresEnCola -= escritura(i);
+                otorgar(i, t);
+                cola.pop_front();
+            }
+            break;
+        case PoliticaRW::PREFERIR_LECTORES:
+            otorgarDeCola(t, false, lectura);
+            if (lectores.empty()) otorgarDeCola(t, true, escritura);
+            break;
+        case PoliticaRW::PREFERIR_ESCRITORES:
+            if (escritoresEnCola == 0) otorgarDeCola(t, false, lectura);
+            else if (lectores.empty()) otorgarDeCola(t, true, escritura);
+            break;
+        }
+    };
+
+    auto llegar = [&](int i, int t) {
+        const bool escritorActivo = finEscritor >= t;
+        bool puede;
+        if (esLectura(acciones[i])) {
+            puede = !escritorActivo && (politica == PoliticaRW::PREFERIR_LECTORES ? true
+                                        : politica == PoliticaRW::PREFERIR_ESCRITORES ? escritoresEnCola == 0
+                                                                                        : cola.empty());
+        } else {
+            puede = !escritorActivo && lectores.empty() &&
+                    (politica == PoliticaRW::JUSTA ? cola.empty() : escritoresEnCola == 0);
+        }
+        if (puede) {
+            otorgar(i, t);
+        } else {
+            cola.push_back(i);
+            escritoresEnCola += !esLectura(acciones[i]);
+        }
+    };
+
+    size_t sig = 0;
+    int anterior = INT_MIN;
+    while (sig < llegadas.size() || !cola.empty()) {
+        int t = sig < llegadas.size() ? acciones[llegadas[sig]].ciclo : INT_MAX;
+        if (!cola.empty()) {
+            // Quien está en cola sólo puede entrar cuando alguien suelta el recurso
+            if (!lectores.empty()) t = std::min(t, lectores.top() + 1);
+            if (finEscritor >= anterior) t = std::min(t, finEscritor + 1);
+        }
+        if (t == INT_MAX) break; // No ocurre: con cola siempre hay alguien adentro
+        while (!lectores.empty() && lectores.top() < t) lectores.pop();
+        atenderCola(t);
+        for (; sig < llegadas.size() && acciones[llegadas[sig]].ciclo == t; ++sig) {
+            llegar(llegadas[sig], t);
+        }
+        anterior = t;
+    }
+}
+
+// Simula una partición (uno o varios recursos completos). `indices` llega
+// en orden de archivo; otorgado se escribe indexado por acción.
+void simularParticion(const std::map<std::string, Recurso>& recursos, const std::vector<Accion>& acciones,
+                      const std::vector<int>& indices, const OpcionesSync& opciones, int* otorgado,
+                      int& ultimoCiclo, AcumuladoRW& acumulado) {
+    const int retencion = std::max(1, opciones.ciclosRetencion);
+    if (opciones.lectoresEscritores) {
+        std::unordered_map<std::string, std::vector<int>> llegadas;
+        for (int i : ordenPorCiclo(acciones, indices)) llegadas[acciones[i].recurso].push_back(i);
+        for (const auto& entrada : llegadas) {
+            simularRecursoRW(acciones, entrada.second, opciones.politicaRW, retencion, otorgado, ultimoCiclo,
+                             acumulado);
+        }
+        return;
+    }
+
+    std::unordered_map<std::string, EstadoRecurso> estados;
+    for (int i : ordenPorCiclo(acciones, indices)) {
+        const Accion& a = acciones[i];
+        auto [it, nuevo] = estados.try_emplace(a.recurso);
+        EstadoRecurso& r = it->second;
+        if (nuevo) {
+            int c = 1;
+            if (!opciones.mutex) {
+                auto declarado = recursos.find(a.recurso);
+                c = declarado != recursos.end() ? declarado->second.contador_inicial : 0;
+            }
+            r.capacidad = std::max(c, opciones.capacidadMinima);
+        }
+        while (!r.fines.empty() && r.fines.top() < a.ciclo) r.fines.pop();
+        if ((int)r.fines.size() < r.capacidad) {
+            otorgado[i] = a.ciclo;
+            r.fines.push(a.ciclo + retencion - 1);
+            ultimoCiclo = std::max(ultimoCiclo, a.ciclo + retencion - 1);
+        }
+    }
+}
+
+}
+
+ResultadoSync simularSyncParticionado(const std::map<std::string, Recurso>& recursos,
+                                      const std::vector<Accion>& acciones, const OpcionesSync& opciones) {
+    INSTR_FASE("sync_particionado");
+    ResultadoSync resultado;
+    const size_t n = acciones.size();
+
+    unsigned hilos = opciones.hilos ? opciones.hilos : std::thread::hardware_concurrency();
+    hilos = std::max(1u, hilos);
+
+    // Cada recurso cae completo en una partición según el hash de su nombre.
+    // Varias particiones por hilo reparten mejor la carga de recursos muy usados.
+    const int k = hilos == 1 ? 1 : hilos * 8;
+    std::vector<std::vector<int>> particiones(k);
+    std::vector<int> validas;
+    validas.reserve(n);
+    std::hash<std::string> hash;
+    for (size_t i = 0; i < n; ++i) {
+        if (acciones[i].ciclo < 0) continue;
+        validas.push_back((int)i);
+        particiones[k == 1 ? 0 : hash(acciones[i].recurso) % k].push_back((int)i);
+    }
+    for (const auto& p : particiones) {
+        resultado.particiones += !p.empty();
+    }
+
+    resultado.otorgado.assign(n, -1); // Cada acción pertenece a una sola partición
+    std::vector<int> ultimos(k, -1);
+    std::vector<AcumuladoRW> acumulados(k);
+    auto cancelado = [&]() { return opciones.cancelacion && opciones.cancelacion->cancelado(); };
+    std::atomic<int> siguiente{0};
+    auto trabajador = [&]() {
+        for (int p = siguiente++; p < k && !cancelado(); p = siguiente++) {
+            simularParticion(recursos, acciones, particiones[p], opciones, resultado.otorgado.data(), ultimos[p],
+                             acumulados[p]);
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    for (unsigned h = 1; h < std::min<unsigned>(hilos, k); ++h) {
+        trabajadores.emplace_back(trabajador);
+    }
+    // Mientras tanto, el orden de la mezcla: no depende de los resultados
+    std::vector<int> orden = ordenPorCiclo(acciones, validas);
+    trabajador();
+    for (auto& t : trabajadores) {
+        t.join();
+    }
+    if (cancelado()) {
+        resultado.cancelado = true;
+        return resultado;
+    }
+
+    for (int p = 0; p < k; ++p) {
+        resultado.ultimoCiclo = std::max(resultado.ultimoCiclo, ultimos[p]);
+        resultado.ciclosLector += acumulados[p].ciclosLector;
+        resultado.ciclosConLectores += acumulados[p].ciclosConLectores;
+        resultado.maxLectores = std::max(resultado.maxLectores, acumulados[p].maxLectores);
+    }
+
+    // Las entradas tardías (sólo en lectores/escritores) van antes que las
+    // peticiones del mismo ciclo: en la simulación la cola se atiende primero
+    std::vector<int> tardias;
+    for (int i : validas) {
+        if (resultado.otorgado[i] > acciones[i].ciclo) tardias.push_back(i);
+    }
+    tardias = ordenPorClave(tardias, [&](int i) { return resultado.otorgado[i]; });
+
+    resultado.eventos.reserve(orden.size() + tardias.size());
+    size_t t = 0;
+    for (int i : orden) {
+        for (; t < tardias.size() && resultado.otorgado[tardias[t]] <= acciones[i].ciclo; ++t) {
+            resultado.eventos.push_back({resultado.otorgado[tardias[t]], tardias[t], true});
+        }
+        bool acceso = resultado.otorgado[i] == acciones[i].ciclo;
+        resultado.eventos.push_back({acciones[i].ciclo, i, acceso});
+        resultado.accesos += acceso;
+        resultado.esperas += !acceso;
+    }
+    for (; t < tardias.size(); ++t) {
+        resultado.eventos.push_back({resultado.otorgado[tardias[t]], tardias[t], true});
+    }
+    return resultado;
+}
+
+void simularSync(std::map<std::string, Recurso>& recursos, const std::vector<Accion>& acciones,
+                 UpdateCallback& updateGUI, const SimulationConfig& config, const OpcionesSync& opciones) {
+    int max_ciclo = 0;
+    for (const auto& a : acciones) {
+        if (a.ciclo > max_ciclo) max_ciclo = a.ciclo;
+    }
+    max_ciclo += 5; // Margen adicional
+
+    OpcionesSync conToken = opciones;
+    conToken.cancelacion = config.cancelacion;
+    ResultadoSync resultado = simularSyncParticionado(recursos, acciones, conToken);
+    if (resultado.cancelado) return;
+    // Con lectores/escritores las esperas pueden terminar después de la última acción
+    max_ciclo = std::max(max_ciclo, resultado.ultimoCiclo + 1);
+
+    // Sólo se arman los bloques de texto si alguien los consume
+    const bool emitir = updateGUI || config.traza;
+    size_t e = 0;
+    for (int ciclo = 0; ciclo <= max_ciclo && !corridaCancelada(config); ciclo++) {
+        bool accion_realizada = false;
+        for (; e < resultado.eventos.size() && resultado.eventos[e].ciclo == ciclo; ++e) {
+            const Accion& a = acciones[resultado.eventos[e].accion];
+            recursos[a.recurso]; // Los recursos no declarados se crean, como en el modelo por ciclos
+            accion_realizada = true;
+            if (!emitir) continue;
+
+            std::string bloque = "[" + a.pid + "-" + a.tipo + "-" + a.recurso +
+                                 (resultado.eventos[e].accedio ? "-ACCESSED]" : "-WAITING]");
+            if (config.traza) {
+                config.traza->eventoSync(a.recurso, bloque, ciclo);
+            }
+            if (updateGUI) {
+                updateGUI(bloque, ciclo);
+                if (pausaAnimacion(config, 300)) return;
+            }
+        }
+
+        if (!accion_realizada && updateGUI) {
+            updateGUI("CPU IDLE", ciclo);
+            if (pausaAnimacion(config, 300)) return;
+        }
+    }
+}
+
+void simularLectoresEscritores(std::map<std::string, Recurso>& recursos, const std::vector<Accion>& acciones,
+                               UpdateCallback& updateGUI, const SimulationConfig& config, PoliticaRW politica) {
+    INSTR_FASE("lectores_escritores");
+    for (auto& [nombre, r] : recursos) {
+        r.ocupado = false;
+        r.proceso_actual = "";
+        r.procesos_uso.clear();
+    }
+    OpcionesSync opciones;
+    opciones.lectoresEscritores = true;
+    opciones.politicaRW = politica;
+    simularSync(recursos, acciones, updateGUI, config, opciones);
+}
+
+MetricasRW metricasLectoresEscritores(const std::vector<Accion>& acciones, const ResultadoSync& resultado,
+                                      PoliticaRW politica) {
+    MetricasRW m;
+    m.politica = politica;
+    m.lectoresMaximo = resultado.maxLectores;
+    if (resultado.ciclosConLectores > 0) {
+        m.lectoresPromedio = (double)resultado.ciclosLector / resultado.ciclosConLectores;
+    }
+    int primerCiclo = INT_MAX;
+    for (size_t i = 0; i < acciones.size() && i < resultado.otorgado.size(); ++i) {
+        int otorgado = resultado.otorgado[i];
+        if (otorgado < 0) continue;
+        primerCiclo = std::min(primerCiclo, acciones[i].ciclo);
+        m.atendidas++;
+        (esLectura(acciones[i]) ? m.esperaLectores : m.esperaEscritores).agregar(otorgado - acciones[i].ciclo);
+    }
+    if (m.atendidas > 0) {
+        m.makespan = resultado.ultimoCiclo - primerCiclo + 1;
+        m.throughput = (double)m.atendidas / m.makespan;
+    }
+    return m;
+}
+
+std::vector<MetricasRW> compararPoliticasRW(const std::map<std::string, Recurso>& recursos,
+                                            const std::vector<Accion>& acciones, int ciclosRetencion,
+                                            const TokenCancelacion* cancelacion) {
+    std::vector<MetricasRW> metricas;
+    for (PoliticaRW politica : {PoliticaRW::PREFERIR_LECTORES, PoliticaRW::PREFERIR_ESCRITORES, PoliticaRW::JUSTA}) {
+        OpcionesSync opciones;
+        opciones.lectoresEscritores = true;
+        opciones.politicaRW = politica;
+        opciones.ciclosRetencion = ciclosRetencion;
+        opciones.cancelacion = cancelacion;
+        ResultadoSync resultado = simularSyncParticionado(recursos, acciones, opciones);
+        if (resultado.cancelado) return {};
+        metricas.push_back(metricasLectoresEscritores(acciones, resultado, politica));
+    }
+    return metricas;
+}
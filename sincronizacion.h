@@ -0,0 +1,95 @@
+#ifndef SINCRONIZACION_H
+#define SINCRONIZACION_H
+#include "scheduler.h"
+
+// Motor de sincronización particionado por recurso. En el modelo de mutex y
+// semáforos una acción sobre R1 nunca afecta a R2, así que cada recurso cae
+// completo en una partición (por hash de su nombre), las particiones se
+// simulan en paralelo (cada una sólo ve sus propias acciones, sin recorrer
+// los ciclos vacíos) y los resultados se mezclan de vuelta en orden de ciclo
+// y, dentro del ciclo, de archivo: el mismo orden en que el modelo por
+// ciclos procesa las acciones.
+//
+// Una adquisición en el ciclo c retiene el recurso los ciclos
+// c .. c + ciclosRetencion - 1 y se libera al final del último. Una acción
+// que no encuentra lugar queda en WAITING y no se reintenta. Las acciones
+// con ciclo negativo se ignoran, igual que en la simulación ciclo a ciclo.
+//
+// En modo lectores/escritores los READ comparten el recurso y cualquier otra
+// acción es una escritura exclusiva. Ahí nadie se descarta: quien no entra
+// espera en cola hasta que la política se lo otorga.
+enum class PoliticaRW {
+    PREFERIR_LECTORES,   // Un READ entra si no hay escritor activo, aunque haya escritores en cola
+    PREFERIR_ESCRITORES, // Ningún READ entra mientras haya un escritor en cola
+    JUSTA                // Orden de llegada; los READ consecutivos al frente de la cola entran juntos
+};
+
+extern const char* const NOMBRES_POLITICA_RW[3];
+
+struct OpcionesSync {
+    bool mutex = true;               // false: semáforo con capacidad contador_inicial
+    int ciclosRetencion = 1;
+    int capacidadMinima = 0;         // Hilos reales: un semáforo en 0 cuenta como 1
+    unsigned hilos = 0;              // 0 = std::thread::hardware_concurrency()
+    bool lectoresEscritores = false; // Ignora `mutex`: READ compartido, el resto exclusivo
+    PoliticaRW politicaRW = PoliticaRW::JUSTA;
+    const TokenCancelacion* cancelacion = nullptr;
+};
+
+struct EventoSync {
+    int ciclo;
+    int accion;                      // Índice en acciones
+    bool accedio;                    // false: WAITING. En lectores/escritores una acción que
+                                     // esperó vuelve a aparecer ACCESSED en el ciclo en que entra
+};
+
+struct ResultadoSync {
+    std::vector<EventoSync> eventos; // Orden de ciclo y, dentro del ciclo, de archivo
+    std::vector<int> otorgado;       // Ciclo en que cada acción obtuvo el recurso; -1 si nunca
+    int accesos = 0;
+    int esperas = 0;
+    int particiones = 0;             // Particiones con acciones
+    int ultimoCiclo = -1;            // Último ciclo retenido por alguna acción
+    bool cancelado = false;
+
+    // Lectores/escritores, sumado sobre recursos
+    long long ciclosLector = 0;      // Ciclos retenidos por cada lector
+    long long ciclosConLectores = 0; // Ciclos con al menos un lector adentro
+    int maxLectores = 0;             // Lectores simultáneos en un mismo recurso
+};
+
+ResultadoSync simularSyncParticionado(const std::map<std::string, Recurso>& recursos,
+                                      const std::vector<Accion>& acciones, const OpcionesSync& opciones);
+
+// Corrida completa para simularMutex/simularSemaforo: simula en paralelo y
+// luego reproduce los eventos ciclo a ciclo hacia el callback y la traza,
+// con CPU IDLE en los ciclos sin acciones
+void simularSync(std::map<std::string, Recurso>& recursos, const std::vector<Accion>& acciones,
+                 UpdateCallback& updateGUI, const SimulationConfig& config, const OpcionesSync& opciones);
+
+void simularLectoresEscritores(std::map<std::string, Recurso>& recursos, const std::vector<Accion>& acciones,
+                               UpdateCallback& updateGUI, const SimulationConfig& config,
+                               PoliticaRW politica = PoliticaRW::JUSTA);
+
+// Reporte de una política de lectores/escritores. Las esperas van en ciclos,
+// desde el ciclo de la acción hasta que obtiene el recurso.
+struct MetricasRW {
+    PoliticaRW politica = PoliticaRW::JUSTA;
+    double lectoresPromedio = 0;     // Lectores simultáneos mientras el recurso se está leyendo
+    int lectoresMaximo = 0;
+    SketchCuantiles esperaEscritores;
+    SketchCuantiles esperaLectores;
+    int atendidas = 0;
+    int makespan = 0;                // Primer ciclo con acciones hasta la última liberación
+    double throughput = 0;           // Acciones atendidas por ciclo
+};
+
+MetricasRW metricasLectoresEscritores(const std::vector<Accion>& acciones, const ResultadoSync& resultado,
+                                      PoliticaRW politica);
+
+// Las tres políticas sobre las mismas acciones; vacío si se cancela
+std::vector<MetricasRW> compararPoliticasRW(const std::map<std::string, Recurso>& recursos,
+                                            const std::vector<Accion>& acciones, int ciclosRetencion,
+                                            const TokenCancelacion* cancelacion = nullptr);
+
+#endif
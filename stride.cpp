@@ -0,0 +1,110 @@
+#include "motor.h"
+#include "instrumentacion.h"
+#include "traza_simulacion.h"
+#include <algorithm>
+
+void SeleccionStride::preparar(EstadoMotor& e) {
+    porLlegada.resize(e.procesos.size());
+    for (int i = 0; i < (int)porLlegada.size(); ++i) porLlegada[i] = i;
+    std::stable_sort(porLlegada.begin(), porLlegada.end(), [&e](int a, int b) {
+        return e.procesos[a].arrival_time < e.procesos[b].arrival_time;
+    });
+    pase.assign(e.procesos.size(), SIN_PASE);
+}
+
+void SeleccionStride::admitir(EstadoMotor& e) {
+    while (siguiente < (int)porLlegada.size() && e.procesos[porLlegada[siguiente]].arrival_time <= e.tiempo) {
+        int idx = porLlegada[siguiente++];
+        e.procesos[idx].en_cola = true;
+        pase[idx] = paseGlobal;
+        heap.push({pase[idx], idx});
+        INSTR_CONTAR(PUSH_COLA);
+    }
+}
+
+int SeleccionStride::seleccionar(EstadoMotor& e) {
+    admitir(e);
+    if (heap.empty()) {
+        return -1;
+    }
+
+    int idx = heap.top().second;
+    heap.pop();
+    INSTR_CONTAR(POP_COLA);
+    paseGlobal = pase[idx];
+    if (e.config.traza) {
+        e.config.traza->colaListos(e.tiempo, heap.size());
+    }
+    return idx;
+}
+
+void SeleccionStride::despuesDeCiclo(EstadoMotor& e) {
+    const Proceso& p = e.procesos[e.actual];
+    pase[e.actual] += STRIDE1 / boletos(p);
+    if (p.remaining_time == 0 && p.fase == (int)p.es.size()) {
+        pase[e.actual] = SIN_PASE; // No se guarda en los checkpoints
+    }
+}
+
+void SeleccionStride::alExpropiar(EstadoMotor& e, int idx) {
+    heap.push({pase[idx], idx});
+    INSTR_CONTAR(PUSH_COLA);
+}
+
+void SeleccionStride::alVolverDeES(EstadoMotor& e, int idx) {
+    pase[idx] = std::max(pase[idx], paseGlobal);
+    alExpropiar(e, idx);
+}
+
+// En el orden en que se elegirían si nadie más llegara
+std::vector<int> SeleccionStride::colaListos(const EstadoMotor& e) const {
+    std::vector<int> listos = e.listosPorLlegada();
+    auto paseDe = [&](int i) { return e.procesos[i].en_cola ? pase[i] : paseGlobal; };
+    std::stable_sort(listos.begin(), listos.end(), [&](int a, int b) {
+        return std::make_pair(paseDe(a), a) < std::make_pair(paseDe(b), b);
+    });
+    return listos;
+}
+
+// Pase global y (índice, pase) de cada admitido que no ha terminado
+void SeleccionStride::guardar(std::vector<int>& extra) const {
+    auto agregarPase = [&extra](long long v) {
+        extra.push_back((int)(uint32_t)v);
+        extra.push_back((int)(uint32_t)((uint64_t)v >> 32));
+    };
+    agregarPase(paseGlobal);
+    for (int idx = 0; idx < (int)pase.size(); ++idx) {
+        if (pase[idx] != SIN_PASE) {
+            extra.push_back(idx);
+            agregarPase(pase[idx]);
+        }
+    }
+}
+
+// En el montículo quedan los admitidos que esperan el CPU
+void SeleccionStride::restaurar(const EstadoMotor& e, const std::vector<int>& extra) {
+    auto leerPase = [&extra](size_t k) {
+        return (long long)((uint64_t)(uint32_t)extra[k] | ((uint64_t)(uint32_t)extra[k + 1] << 32));
+    };
+    paseGlobal = extra.size() < 2 ? 0 : leerPase(0);
+    std::fill(pase.begin(), pase.end(), SIN_PASE);
+    for (size_t k = 2; k + 2 < extra.size(); k += 3) {
+        pase[extra[k]] = leerPase(k + 1);
+    }
+
+    heap = {};
+    siguiente = 0;
+    for (int i = 0; i < (int)e.procesos.size(); ++i) {
+        const Proceso& p = e.procesos[i];
+        if (p.en_cola || p.terminado) siguiente++;
+        if (p.en_cola && !p.terminado && !p.en_es && i != e.actual) {
+            heap.push({pase[i], i});
+        }
+    }
+}
+
+SimulationResult stride(std::vector<Proceso>& procesos, int quantum, UpdateCallback updateGUI,
+                        const SimulationConfig& config) {
+    return correrPoliticas(procesos, std::move(updateGUI), config, SeleccionStride{},
+                           ExpropiacionPorQuantum{quantum});
+}
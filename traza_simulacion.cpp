@@ -0,0 +1,101 @@
+#include "traza_simulacion.h"
+
+namespace {
+
+std::string escaparJson(const std::string& texto) {
+    std::string salida;
+    for (char c : texto) {
+        if (c == '"' || c == '\\') salida += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        salida += c;
+    }
+    return salida;
+}
+
+}
+
+TrazaSimulacion::TrazaSimulacion(const std::string& archivo) : out(archivo) {
+    out << "{\"traceEvents\":[\n";
+}
+
+TrazaSimulacion::~TrazaSimulacion() {
+    cerrar();
+}
+
+void TrazaSimulacion::iniciarAlgoritmo(const std::string& nombre) {
+    escribirRebanada();
+    algoritmo++;
+    ultimaLongitud = -1;
+    tracksRecurso.clear();
+
+    out << (primero ? "" : ",\n")
+        << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << algoritmo
+        << ",\"args\":{\"name\":\"" << escaparJson(nombre) << "\"}},\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << algoritmo
+        << ",\"tid\":0,\"args\":{\"name\":\"CPU\"}}";
+    primero = false;
+}
+
+void TrazaSimulacion::ciclo(const std::string& contenido, int ciclo) {
+    if (contenido == actual && ciclo == fin) {
+        fin++;
+        return;
+    }
+    escribirRebanada();
+    actual = contenido;
+    inicio = ciclo;
+    fin = ciclo + 1;
+}
+
+void TrazaSimulacion::escribirRebanada() {
+    if (actual.empty() || !out) return;
+
+    const char* categoria = "proceso";
+    if (actual == "IDLE" || actual == "CPU IDLE") categoria = "idle";
+    else if (actual == "CS") categoria = "cambio_contexto";
+
+    out << (primero ? "" : ",\n")
+        << "{\"name\":\"" << escaparJson(actual) << "\",\"cat\":\"" << categoria
+        << "\",\"ph\":\"X\",\"pid\":" << algoritmo << ",\"tid\":0,\"ts\":" << inicio
+        << ",\"dur\":" << fin - inicio << "}";
+    primero = false;
+    actual.clear();
+}
+
+// Cada recurso tiene su propio track para que los eventos simultaneos no se encimen
+int TrazaSimulacion::trackRecurso(const std::string& recurso) {
+    auto it = tracksRecurso.find(recurso);
+    if (it != tracksRecurso.end()) return it->second;
+
+    int tid = tracksRecurso.size() + 1;
+    tracksRecurso[recurso] = tid;
+    out << (primero ? "" : ",\n")
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << algoritmo << ",\"tid\":" << tid
+        << ",\"args\":{\"name\":\"" << escaparJson(recurso) << "\"}}";
+    primero = false;
+    return tid;
+}
+
+void TrazaSimulacion::eventoSync(const std::string& recurso, const std::string& contenido, int ciclo) {
+    int tid = trackRecurso(recurso);
+    const char* categoria = contenido.find("WAITING") != std::string::npos ? "waiting" : "accessed";
+    out << ",\n{\"name\":\"" << escaparJson(contenido) << "\",\"cat\":\"" << categoria
+        << "\",\"ph\":\"X\",\"pid\":" << algoritmo << ",\"tid\":" << tid << ",\"ts\":" << ciclo
+        << ",\"dur\":1}";
+}
+
+void TrazaSimulacion::colaListos(int ciclo, int longitud) {
+    if (longitud == ultimaLongitud) return;
+    ultimaLongitud = longitud;
+    out << (primero ? "" : ",\n")
+        << "{\"name\":\"cola_listos\",\"ph\":\"C\",\"pid\":" << algoritmo << ",\"ts\":" << ciclo
+        << ",\"args\":{\"procesos\":" << longitud << "}}";
+    primero = false;
+}
+
+void TrazaSimulacion::cerrar() {
+    if (!out.is_open()) return;
+    escribirRebanada();
+    out << "\n]}\n";
+    out.close();
+}
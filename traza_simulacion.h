@@ -0,0 +1,37 @@
+#ifndef TRAZA_SIMULACION_H
+#define TRAZA_SIMULACION_H
+#include <fstream>
+#include <map>
+#include <string>
+
+// Escritor en streaming del calendario simulado en formato Chrome trace
+// (chrome://tracing, Perfetto). Cada algoritmo es un proceso de la traza con
+// un track de CPU, los ciclos consecutivos del mismo contenido se agrupan en
+// una sola rebanada y 1 ciclo se representa como 1 microsegundo.
+class TrazaSimulacion {
+public:
+    explicit TrazaSimulacion(const std::string& archivo);
+    ~TrazaSimulacion();
+
+    bool abierta() const { return static_cast<bool>(out); }
+    void iniciarAlgoritmo(const std::string& nombre);
+    void ciclo(const std::string& contenido, int ciclo);
+    void eventoSync(const std::string& recurso, const std::string& contenido, int ciclo);
+    void colaListos(int ciclo, int longitud);
+    void cerrar();
+
+private:
+    void escribirRebanada();
+    int trackRecurso(const std::string& recurso);
+
+    std::ofstream out;
+    bool primero = true;
+    int algoritmo = 0;
+    std::string actual;
+    int inicio = 0;
+    int fin = 0;
+    int ultimaLongitud = -1;
+    std::map<std::string, int> tracksRecurso;
+};
+
+#endif
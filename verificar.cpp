@@ -0,0 +1,284 @@
+// verificar.cpp
+// Comprueba que los caminos rápidos den exactamente lo mismo que el camino
+// de referencia sobre cargas generadas. Sale con 1 ante cualquier diferencia:
+//
+//   make check
+//   ./scheduler_check --casos 10000 --semilla 7
+//
+//   forma cerrada   FIFO, SJF y Priority con soloMetricas contra el motor
+//                   ciclo a ciclo: tiempos por proceso y métricas
+//   sincronizacion  simularSyncParticionado contra el modelo por ciclos que
+//                   recorre todas las acciones en cada ciclo, en mutex y
+//                   semáforo, con uno y con varios hilos
+//   en linea        CalendarizadorOnline contra el motor por lotes sobre la
+//                   carga completa: timeline, tiempos por proceso y métricas
+#include "motor.h"
+#include "sincronizacion.h"
+#include "calendarizador_online.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+struct Opciones {
+    int casos = 3000;        // Casos por comprobación
+    unsigned semilla = 1;
+};
+
+// Cuenta casos y diferencias de una comprobación; muestra las primeras
+class Conteo {
+public:
+    explicit Conteo(const char* nombre) : nombre(nombre) {}
+
+    void caso(bool igual, const char* detalle, int carga) {
+        casos++;
+        if (igual) return;
+        if (++diferencias <= 5) {
+            std::printf("  %s: difiere en la carga %d (%s)\n", nombre, carga, detalle);
+        }
+    }
+    bool reportar() const {
+        std::printf("%-16s %8ld casos, %ld diferencias\n", nombre, casos, diferencias);
+        return diferencias == 0;
+    }
+
+private:
+    const char* nombre;
+    long casos = 0;
+    long diferencias = 0;
+};
+
+const char* nombreAlgoritmo(Algoritmo a) {
+    static const char* nombres[] = {"FIFO", "SJF", "SRT", "Round Robin", "Priority", "Lottery", "Stride"};
+    return nombres[(int)a];
+}
+
+bool mismasMetricas(const SimulationResult& a, const SimulationResult& b) {
+    return a.avgWaitingTime == b.avgWaitingTime && a.avgTurnaroundTime == b.avgTurnaroundTime &&
+           a.avgResponseTime == b.avgResponseTime && a.contextSwitches == b.contextSwitches &&
+           a.makespan == b.makespan && a.cpuUtilization == b.cpuUtilization && a.throughput == b.throughput &&
+           a.ciclosOcupados == b.ciclosOcupados && a.primerCiclo == b.primerCiclo &&
+           a.ultimoCiclo == b.ultimoCiclo && a.waiting.cuantil(0.95) == b.waiting.cuantil(0.95) &&
+           a.response.cuantil(0.5) == b.response.cuantil(0.5) && a.turnaround.maximo() == b.turnaround.maximo();
+}
+
+std::array<int, 5> tiempos(const Proceso& p) {
+    return {p.start_time, p.completion_time, p.waiting_time, p.turnaround_time, p.response_time};
+}
+
+// Cargas pequeñas con pids repetidos, llegadas simultáneas y, si se pide,
+// ráfagas de E/S en tres dispositivos
+std::vector<Proceso> cargaAleatoria(std::mt19937& gen, int n, bool conES, bool todasEnCero) {
+    std::exponential_distribution<> entreLlegadas(1.0 / 7.0);
+    std::uniform_int_distribution<> rafaga(1, 12), prioridad(1, 5), dispositivo(0, 2), duracion(1, 6), cuarto(0, 3);
+    std::vector<Proceso> procesos(n);
+    double llegada = 0;
+    for (int i = 0; i < n; ++i) {
+        Proceso& p = procesos[i];
+        p.pid = "P" + std::to_string(i + 1);
+        p.burst_time = rafaga(gen);
+        p.arrival_time = todasEnCero ? 0 : (int)llegada;
+        p.priority = prioridad(gen);
+        p.remaining_time = p.burst_time;
+        if (conES && cuarto(gen) == 0) {
+            for (int k = 1 + cuarto(gen); k > 0; --k) {
+                p.es.push_back({dispositivo(gen), duracion(gen), rafaga(gen)});
+            }
+        }
+        llegada += entreLlegadas(gen);
+    }
+    return procesos;
+}
+
+bool verificarFormaCerrada(const Opciones& op) {
+    Conteo conteo("forma cerrada");
+    std::mt19937 gen(op.semilla);
+    for (int w = 0; w < op.casos; ++w) {
+        // Llegadas desordenadas, en cero o con pids repetidos según la carga
+        int n = gen() % 60;
+        std::vector<Proceso> carga(n);
+        for (Proceso& p : carga) {
+            p.pid = "P" + std::to_string(gen() % (w % 2 ? n + 1 : 4));
+            p.burst_time = 1 + gen() % 9;
+            p.arrival_time = w % 3 == 0 ? 0 : gen() % 80;
+            p.priority = gen() % 4;
+        }
+        for (Algoritmo a : {Algoritmo::FIFO, Algoritmo::SJF, Algoritmo::PRIORITY}) {
+            for (int cs = 0; cs < 3; ++cs) {
+                SimulationConfig motor;
+                motor.contextSwitch = cs;
+                motor.guardarTimeline = false;
+                SimulationConfig cerrada = motor;
+                cerrada.soloMetricas = true;
+                std::vector<Proceso> porCiclos = carga, directo = carga;
+                SimulationResult r1 = correrAlgoritmo(a, porCiclos, motor);
+                SimulationResult r2 = correrAlgoritmo(a, directo, cerrada);
+
+                bool igual = mismasMetricas(r1, r2) && r2.timeline.empty();
+                for (int i = 0; igual && i < n; ++i) {
+                    const Proceso& x = porCiclos[i];
+                    const Proceso& y = directo[i];
+                    igual = x.pid == y.pid && tiempos(x) == tiempos(y) && x.remaining_time == y.remaining_time &&
+                            x.terminado == y.terminado && x.en_cola == y.en_cola;
+                }
+                conteo.caso(igual, nombreAlgoritmo(a), w);
+            }
+        }
+    }
+    return conteo.reportar();
+}
+
+// El modelo original: en cada ciclo recorre todas las acciones y atiende las
+// de ese ciclo en orden de archivo
+std::vector<EventoSync> syncPorCiclos(const std::map<std::string, Recurso>& recursos,
+                                      const std::vector<Accion>& acciones, const OpcionesSync& opciones) {
+    const int retencion = std::max(1, opciones.ciclosRetencion);
+    int maxCiclo = -1;
+    for (const Accion& a : acciones) maxCiclo = std::max(maxCiclo, a.ciclo);
+
+    std::map<std::string, std::vector<int>> fines; // Último ciclo de cada retención vigente
+    std::vector<EventoSync> eventos;
+    for (int ciclo = 0; ciclo <= maxCiclo; ++ciclo) {
+        for (size_t i = 0; i < acciones.size(); ++i) {
+            const Accion& a = acciones[i];
+            if (a.ciclo != ciclo) continue;
+            int capacidad = 1;
+            if (!opciones.mutex) {
+                auto declarado = recursos.find(a.recurso);
+                capacidad = declarado != recursos.end() ? declarado->second.contador_inicial : 0;
+            }
+            capacidad = std::max(capacidad, opciones.capacidadMinima);
+
+            std::vector<int>& f = fines[a.recurso];
+            f.erase(std::remove_if(f.begin(), f.end(), [&](int fin) { return fin < ciclo; }), f.end());
+            bool accede = (int)f.size() < capacidad;
+            if (accede) f.push_back(ciclo + retencion - 1);
+            eventos.push_back({ciclo, (int)i, accede});
+        }
+    }
+    return eventos;
+}
+
+bool mismosEventos(const std::vector<EventoSync>& a, const std::vector<EventoSync>& b) {
+    auto igual = [](const EventoSync& x, const EventoSync& y) {
+        return x.ciclo == y.ciclo && x.accion == y.accion && x.accedio == y.accedio;
+    };
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), igual);
+}
+
+bool verificarSincronizacion(const Opciones& op) {
+    Conteo conteo("sincronizacion");
+    std::mt19937 gen(op.semilla);
+    for (int w = 0; w < op.casos; ++w) {
+        // Semáforos de capacidad 0 a 3, acciones con ciclo negativo y sobre
+        // un recurso no declarado
+        int numRecursos = 1 + gen() % 8;
+        std::map<std::string, Recurso> recursos;
+        for (int r = 0; r < numRecursos; ++r) {
+            Recurso rec;
+            rec.nombre = "R" + std::to_string(r);
+            rec.contador = rec.contador_inicial = gen() % 4;
+            recursos[rec.nombre] = rec;
+        }
+        std::vector<Accion> acciones(gen() % 60);
+        for (size_t i = 0; i < acciones.size(); ++i) {
+            acciones[i] = {"P" + std::to_string(i), gen() % 2 ? "READ" : "WRITE",
+                           "R" + std::to_string(gen() % (numRecursos + 1)), (int)(gen() % 25) - 2};
+        }
+
+        for (bool mutex : {true, false}) {
+            OpcionesSync opciones;
+            opciones.mutex = mutex;
+            opciones.ciclosRetencion = 1 + w % 4;
+            opciones.capacidadMinima = w % 5 == 0;
+            std::vector<EventoSync> referencia = syncPorCiclos(recursos, acciones, opciones);
+            int accesos = std::count_if(referencia.begin(), referencia.end(),
+                                        [](const EventoSync& e) { return e.accedio; });
+
+            for (unsigned hilos : {1u, 0u}) {
+                opciones.hilos = hilos;
+                ResultadoSync r = simularSyncParticionado(recursos, acciones, opciones);
+                bool igual = mismosEventos(referencia, r.eventos) && r.accesos == accesos &&
+                             r.esperas == (int)referencia.size() - accesos;
+                conteo.caso(igual, mutex ? "mutex" : "semaforo", w);
+            }
+        }
+    }
+    return conteo.reportar();
+}
+
+bool verificarEnLinea(const Opciones& op) {
+    Conteo conteo("en linea");
+    std::mt19937 gen(op.semilla);
+    const Algoritmo algoritmos[] = {Algoritmo::FIFO, Algoritmo::SJF, Algoritmo::SRT, Algoritmo::ROUND_ROBIN,
+                                    Algoritmo::PRIORITY};
+    // Cinco algoritmos y dos cambios de contexto por carga
+    for (int w = 0; w < std::max(1, op.casos / 10); ++w) {
+        bool conES = w % 2;
+        int quantum = 1 + w % 4;
+        for (Algoritmo a : algoritmos) {
+            // Priority por lotes no mira las llegadas: sólo coincide con todas en 0
+            bool todasEnCero = a == Algoritmo::PRIORITY || w % 7 == 0;
+            std::vector<Proceso> carga = cargaAleatoria(gen, 50 + gen() % 200, conES, todasEnCero);
+            for (int cs : {0, 2}) {
+                SimulationConfig config;
+                config.contextSwitch = cs;
+                config.guardarTimeline = false;
+
+                std::vector<std::pair<std::string, int>> lotes, enLinea;
+                std::unique_ptr<MotorCalendarizacion> motor = crearMotor(a, carga, config, quantum);
+                motor->setObservador([&](const std::string& c, int ciclo) { lotes.push_back({c, ciclo}); });
+                motor->runToEnd();
+                std::map<std::string, std::array<int, 5>> porLotes, porFlujo;
+                for (const Proceso& p : motor->procesos()) porLotes[p.pid] = tiempos(p);
+
+                size_t siguiente = 0;
+                auto fuente = [&](Proceso& p) {
+                    if (siguiente == carga.size()) return false;
+                    p = carga[siguiente++];
+                    return true;
+                };
+                std::unique_ptr<CalendarizadorOnline> online = crearCalendarizadorOnline(a, fuente, config, quantum);
+                online->setObservador([&](const std::string& c, int ciclo) { enLinea.push_back({c, ciclo}); });
+                online->setAlTerminar([&](const Proceso& p) { porFlujo[p.pid] = tiempos(p); });
+                online->runToEnd();
+
+                const SimulationResult& r1 = motor->resultado();
+                const SimulationResult& r2 = online->resultado();
+                bool igual = lotes == enLinea && porLotes == porFlujo && r1.contextSwitches == r2.contextSwitches &&
+                             r1.avgWaitingTime == r2.avgWaitingTime && r1.ciclosOcupadosES == r2.ciclosOcupadosES;
+                conteo.caso(igual, nombreAlgoritmo(a), w);
+            }
+        }
+    }
+    return conteo.reportar();
+}
+
+Opciones leerOpciones(int argc, char** argv) {
+    Opciones op;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hayValor = i + 1 < argc;
+        if (arg == "--casos" && hayValor) op.casos = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--semilla" && hayValor) op.semilla = std::strtoul(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "Uso: %s [--casos N] [--semilla S]\n", argv[0]);
+            std::exit(1);
+        }
+    }
+    return op;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Opciones op = leerOpciones(argc, argv);
+    bool ok = verificarFormaCerrada(op);
+    ok = verificarSincronizacion(op) && ok;
+    ok = verificarEnLinea(op) && ok;
+    std::printf(ok ? "Sin diferencias\n" : "HAY DIFERENCIAS\n");
+    return ok ? 0 : 1;
+}